@@ -51,6 +51,7 @@
 #include "Core/Element.h"
 #include "Core/ElementDocument.h"
 #include "Core/ElementInstancer.h"
+#include "Core/MemoryInterface.h"
 #include "Core/ElementScroll.h"
 #include "Core/ElementText.h"
 #include "Core/ElementUtilities.h"
@@ -70,6 +71,7 @@
 #include "Core/Input.h"
 #include "Core/Log.h"
 #include "Core/Plugin.h"
+#include "Core/ProfilingInterface.h"
 #include "Core/PropertiesIteratorView.h"
 #include "Core/Property.h"
 #include "Core/PropertyDefinition.h"
@@ -41,6 +41,20 @@ using XMLAttributes = Dictionary;
 
 enum class XMLDataType { Text, CData, InnerXML };
 
+/// A single handler call made during a parse, as stored in an XMLRecording.
+struct XMLRecordedEvent
+{
+	enum class Type { ElementStart, ElementEnd, Data };
+	Type type = Type::Data;
+	XMLDataType data_type = XMLDataType::Text;
+	int line_number = 0;
+	int line_number_open_tag = 0;
+	// The element name, or the data for data events.
+	String value;
+	XMLAttributes attributes;
+};
+using XMLRecording = Vector<XMLRecordedEvent>;
+
 /**
 	@author Peter Curry
  */
@@ -67,6 +81,14 @@ class RMLUICORE_API BaseXMLParser
 		/// Parses the given stream as an XML file, and calls the handlers when
 		/// interesting phenomena are encountered.
 		void Parse(Stream* stream);
+		/// Parses the given stream as above, additionally storing every handler call in the recording.
+		/// @param[in] stream The stream to parse.
+		/// @param[out] recording The recording to append the handler calls to.
+		void Parse(Stream* stream, XMLRecording& recording);
+		/// Calls the handlers as stored in a recording of an earlier parse, without reading any XML source.
+		/// @param[in] source_url The source URL reported to the handlers.
+		/// @param[in] recording The recording to replay.
+		void Replay(const URL& source_url, const XMLRecording& recording);
 
 		/// Get the line number in the stream.
 		/// @return The line currently being processed in the XML stream.
@@ -86,6 +108,7 @@ class RMLUICORE_API BaseXMLParser
 
 	private:
 		const URL* source_url = nullptr;
+		XMLRecording* recording = nullptr;
 		String xml_source;
 		size_t xml_index = 0;
 
@@ -96,6 +119,7 @@ class RMLUICORE_API BaseXMLParser
 		void HandleElementStartInternal(const String& name, const XMLAttributes& attributes);
 		void HandleElementEndInternal(const String& name);
 		void HandleDataInternal(const String& data, XMLDataType type);
+		XMLRecordedEvent RecordEvent(XMLRecordedEvent::Type type, const String& value) const;
 
 		void ReadHeader();
 		void ReadBody();
@@ -38,9 +38,11 @@
 namespace Rml {
 
 class Stream;
+class Compositor;
 class ContextInstancer;
 class ElementDocument;
 class EventListener;
+class HitTestGrid;
 class RenderInterface;
 class DataModel;
 class DataModelConstructor;
@@ -87,6 +89,29 @@ public:
 	/// Renders all visible elements in the context's documents.
 	bool Render();
 
+	/// Returns true if anything that may affect the rendered output changed since the last call to Render(). Applications
+	/// may skip rendering clean contexts and reuse their previous output instead. All contexts become dirty whenever a
+	/// texture handle is released, e.g. when a font face layer regenerates its textures, because the previous output
+	/// may reference it.
+	bool IsRenderDirty() const;
+	/// Marks the context as changed, so that the next call to IsRenderDirty() returns true.
+	void SetRenderDirty();
+
+	/// Returns the number of layout roots formatted during the last call to Update(). A layout root is either a whole
+	/// document, or a layout boundary which had only its own contents changed.
+	int GetNumLayoutRoots() const;
+	/// Returns the number of elements formatted by the layout engine during the last call to Update().
+	int GetNumLayoutElements() const;
+	/// Returns the time in seconds spent updating style, data bindings and structure during the last call to Update().
+	double GetStyleUpdateTime() const;
+	/// Returns the time in seconds spent formatting and positioning documents during the last call to Update().
+	double GetLayoutUpdateTime() const;
+
+	/// Returns the number of bytes currently allocated from the element arenas of the context's documents.
+	size_t GetNumElementArenaBytes() const;
+	/// Returns the number of objects currently allocated from the element arenas of the context's documents.
+	int GetNumElementArenaAllocations() const;
+
 	/// Creates a new, empty document and places it into this context.
 	/// @param[in] instancer_name The name of the instancer used to create the document.
 	/// @return The new document, or nullptr if no document could be created.
@@ -125,6 +150,8 @@ public:
 	ElementDocument* GetDocument(int index);
 	/// Returns the number of documents in the context.
 	int GetNumDocuments() const;
+	/// Forces the layout and decorators of all documents to be regenerated, such as when texture dimensions have changed.
+	void DirtyLayoutAndDecorators();
 
 	/// Returns the hover element.
 	/// @return The element the mouse cursor is hovering over.
@@ -295,6 +322,26 @@ private:
 	// Mouse position during the last mouse_down event.
 	Vector2i last_click_mouse_position;
 
+	// Set when anything that may affect the rendered output changes, cleared on render.
+	bool render_dirty = true;
+	// The texture release version at the last render, see TextureResource::GetReleaseVersion().
+	int render_texture_version = 0;
+
+	// Layout and timing statistics of the last update.
+	int num_layout_roots = 0;
+	int num_layout_elements = 0;
+	double style_update_time = 0;
+	double layout_update_time = 0;
+
+	// Spatial index for finding the element under a point, built on demand.
+	mutable UniquePtr<HitTestGrid> hit_test_grid;
+	mutable bool hit_test_grid_dirty = true;
+	// The number of queries since the grid was last dirtied.
+	mutable int num_hit_tests_while_dirty = 0;
+
+	// Runs the transform and opacity animations of our elements without restyling them.
+	UniquePtr<Compositor> compositor;
+
 	// Enables cursor handling.
 	bool enable_cursor;
 	String cursor_name;
@@ -335,6 +382,11 @@ private:
 	// Internal callback for when a new element gains focus.
 	bool OnFocusChange(Element* element);
 
+	// Marks the hit test grid stale, after elements moved, resized, or changed stacking order.
+	void DirtyHitTestGrid();
+	// Returns true if the hit test grid can answer queries, rebuilding it if that is worth it.
+	bool UseHitTestGrid() const;
+
 	// Generates an event for faking clicks on an element.
 	void GenerateClickEvent(Element* element);
 
@@ -85,9 +85,13 @@ public:
 	/// @param[in] source The opacity information for the source buffer.
 	/// @param[in] source_dimensions The size of the source region (in pixels). The stride is assumed to be equivalent to the horizontal width.
 	/// @param[in] source_offset The offset of the source region from the destination region. This is usually the same as the kernel size.
+	/// @note Separable filters, such as blurs, run fastest as two filters with one-dimensional kernels, see FontEffectBlur.
 	void Run(byte* destination, Vector2i destination_dimensions, int destination_stride, ColorFormat destination_color_format, const byte* source, Vector2i source_dimensions, Vector2i source_offset) const;
 
 private:
+	template <FilterOperation Operation>
+	void RunRows(byte* destination, Vector2i destination_dimensions, int destination_stride, ColorFormat destination_color_format, const float* padded, int padded_stride, float* accumulator) const;
+
 	Vector2i kernel_size;
 	UniquePtr<float[]> kernel;
 
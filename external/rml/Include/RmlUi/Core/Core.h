@@ -40,6 +40,8 @@ class Plugin;
 class Context;
 class FileInterface;
 class FontEngineInterface;
+class MemoryInterface;
+class ProfilingInterface;
 class RenderInterface;
 class SystemInterface;
 enum class DefaultActionPhase;
@@ -91,6 +93,22 @@ RMLUICORE_API FileInterface* GetFileInterface();
 RMLUICORE_API void SetFontEngineInterface(FontEngineInterface* font_interface);
 /// Returns RmlUi's font interface.
 RMLUICORE_API FontEngineInterface* GetFontEngineInterface();
+
+/// Sets the interface through which RmlUi allocates its element arenas, object pools and geometry. This is not required
+/// to be called, but if it is it must be called before Initialise().
+/// @param[in] memory_interface A non-owning pointer to the application-specified memory interface.
+/// @lifetime The interface must be kept alive until after the call to Rml::Shutdown, and until all elements and geometry are released.
+RMLUICORE_API void SetMemoryInterface(MemoryInterface* memory_interface);
+/// Returns RmlUi's memory interface, or nullptr if memory is allocated from the heap.
+RMLUICORE_API MemoryInterface* GetMemoryInterface();
+
+/// Sets the interface receiving RmlUi's profiling zones. Zones are only emitted when the library is built with
+/// RMLUI_CUSTOM_PROFILING defined.
+/// @param[in] profiling_interface A non-owning pointer to the application-specified profiling interface, or nullptr.
+/// @lifetime The interface must be kept alive until after the call to Rml::Shutdown.
+RMLUICORE_API void SetProfilingInterface(ProfilingInterface* profiling_interface);
+/// Returns RmlUi's profiling interface, or nullptr if none is set.
+RMLUICORE_API ProfilingInterface* GetProfilingInterface();
 	
 /// Creates a new element context.
 /// @param[in] name The new name of the context. This must be unique.
@@ -144,8 +162,12 @@ RMLUICORE_API EventId RegisterEventType(const String& type, bool interruptible,
 
 /// Returns a list of source URLs to textures in all loaded documents.
 RMLUICORE_API StringList GetTextureSourceList();
-/// Forces all texture handles loaded and generated by RmlUi to be released.
-RMLUICORE_API void ReleaseTextures();
+/// Forces all texture handles loaded and generated by RmlUi to be released. Cached documents are dropped as well.
+/// @param[in] render_interface Release only the textures bound through this render interface, or all if nullptr.
+RMLUICORE_API void ReleaseTextures(RenderInterface* render_interface = nullptr);
+/// Releases the texture loaded from the given source, it is loaded again through the render interface the next time it
+/// is used. The layout and decorators of all documents are dirtied so that any change in its dimensions is picked up.
+RMLUICORE_API void ReleaseTexture(const String& source);
 /// Forces all compiled geometry handles generated by RmlUi to be released.
 RMLUICORE_API void ReleaseCompiledGeometry();
 
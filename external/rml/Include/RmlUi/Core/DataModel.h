@@ -69,6 +69,10 @@ public:
 
 	bool CallTransform(const String& name, Variant& inout_result, const VariantList& arguments) const;
 
+	// Expressions parsed while enabled are compiled, otherwise they run on the instruction interpreter.
+	void SetCompileExpressions(bool compile);
+	bool GetCompileExpressions() const;
+
 	// Elements declaring 'data-model' need to be attached.
 	void AttachModelRootElement(Element* element);
 	ElementList GetAttachedModelRootElements() const;
@@ -92,6 +96,8 @@ private:
 
 	const TransformFuncRegister* transform_register;
 
+	bool compile_expressions = true;
+
 	SmallUnorderedSet<Element*> attached_elements;
 };
 
@@ -183,6 +189,12 @@ public:
 		type_register->GetTransformFuncRegister()->Register(name, std::move(transform_func));
 	}
 
+	// Compile the data expressions of this model, enabled by default.
+	// @note Applies to expressions parsed afterwards, that is, to documents loaded after this call.
+	void SetCompileExpressions(bool compile) {
+		model->SetCompileExpressions(compile);
+	}
+
 	explicit operator bool() { return model && type_register; }
 
 private:
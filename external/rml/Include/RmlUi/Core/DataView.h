@@ -100,6 +100,8 @@ protected:
 private:
 	ObserverPtr<Element> attached_element;
 	int element_depth;
+
+	friend class DataViews;
 };
 
 
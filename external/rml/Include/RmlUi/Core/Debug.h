@@ -104,7 +104,7 @@ struct RmlUiAssertNonrecursive {
 };
 
 #define RMLUI_ASSERT_NONRECURSIVE \
-static bool rmlui_nonrecursive_entered = false; \
+static thread_local bool rmlui_nonrecursive_entered = false; \
 RmlUiAssertNonrecursive rmlui_nonrecursive(rmlui_nonrecursive_entered)
 
 } // namespace Rml
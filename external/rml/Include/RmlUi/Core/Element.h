@@ -42,12 +42,15 @@
 
 namespace Rml {
 
+class Compositor;
 class Context;
 class DataModel;
 class Decorator;
+class ElementArena;
 class ElementInstancer;
 class EventDispatcher;
 class EventListener;
+class HitTestGrid;
 class ElementDecoration;
 class ElementDefinition;
 class ElementDocument;
@@ -646,12 +649,28 @@ private:
 	static void BuildStackingContextForTable(Vector<StackingOrderedChild>& ordered_children, Element* child);
 	void DirtyStackingContext();
 
+	// Returns true if any descendant of the element may escape the element's clipping region, including descendants in
+	// nested stacking contexts. The result is cached until the clip property or the children of a descendant change.
+	bool HasClipIgnoringDescendant();
+	void DirtyClipIgnoringDescendant();
+
+	// Tells our context that its rendered output may have changed.
+	void DirtyRender();
+	// Tells our context that elements may have moved, resized or changed stacking order, so its hit test grid is stale.
+	void DirtyHitTest();
+
 	void DirtyStructure();
 	void UpdateStructure();
 
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
 
+	/// Returns true if none of our border boxes intersect the context's active clipping region, in which case there is nothing of ours to render.
+	bool IsOutsideActiveClipRegion();
+
+	/// Dirties the decorators of this element and all its descendants.
+	void DirtyDecoratorsRecursive();
+
 	/// Start an animation, replacing any existing animations of the same property name. If start_value is null, the element's current value is used.
 	ElementAnimationList::iterator StartAnimation(PropertyId property_id, const Property * start_value, int num_iterations, bool alternate_direction, float delay, bool initiated_by_animation_property);
 
@@ -672,6 +691,11 @@ private:
 	/// Advances the animations (including transitions) forward in time.
 	void AdvanceAnimations();
 
+	/// Returns the value of a property animated by our context's compositor, or nullptr if it does not animate it.
+	const Property* GetCompositedProperty(PropertyId id) const;
+	/// Takes back our animations from our context's compositor, so they can be changed.
+	void ReclaimCompositedAnimations();
+
 	// Original tag this element came from.
 	String tag;
 
@@ -738,6 +762,10 @@ private:
 
 	bool structure_dirty;
 
+	// Cached result of HasClipIgnoringDescendant(), valid unless dirty.
+	bool clip_ignoring_descendant;
+	bool clip_ignoring_descendant_dirty;
+
 	bool computed_values_are_default_initialized;
 
 	// Transform state
@@ -748,11 +776,18 @@ private:
 	ElementAnimationList animations;
 	bool dirty_animation;
 	bool dirty_transition;
+	// True while our context's compositor runs some of our animations.
+	bool composited_animations;
 
 	ElementMeta* meta;
+	// The arena of the document the element was created in, if it was allocated from one.
+	ElementArena* arena;
 
+	friend class Rml::Compositor;
 	friend class Rml::Context;
+	friend class Rml::ElementArena;
 	friend class Rml::ElementStyle;
+	friend class Rml::HitTestGrid;
 	friend class Rml::LayoutEngine;
 	friend class Rml::LayoutBlockBox;
 	friend class Rml::LayoutInlineBox;
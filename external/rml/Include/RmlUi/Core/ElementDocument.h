@@ -148,8 +148,12 @@ private:
 	/// Updates all sizes defined by the 'lp' unit.
 	void DirtyDpProperties();
 
+	/// Marks the given layout boundary as needing to format its contents, instead of the whole document.
+	void DirtyLayoutBoundary(Element* boundary);
+
 	/// Updates the layout if necessary.
-	void UpdateLayout();
+	/// @return The number of layout roots formatted.
+	int UpdateLayout();
 
 	/// Updates the position of the document based on the style properties.
 	void UpdatePosition();
@@ -172,10 +176,17 @@ private:
 
 	// Is the layout dirty?
 	bool layout_dirty;
+	// Layout boundaries which need to format their contents, only used while the document layout is clean.
+	Vector< ObserverPtr<Element> > dirty_layout_boundaries;
+
+	// Allocates the elements created in this document, created on demand.
+	ElementArena* arena = nullptr;
 
 	bool position_dirty;
 
 	friend class Rml::Context;
+	friend class Rml::Element;
+	friend class Rml::ElementArena;
 	friend class Rml::Factory;
 
 };
@@ -153,6 +153,8 @@ public:
 	static void ClearStyleSheetCache();
 	/// Clears the template cache. This will force template to be reloaded.
 	static void ClearTemplateCache();
+	/// Clears the document cache. This will force documents to be parsed again.
+	static void ClearDocumentCache();
 
 	/// Registers an instancer for all events.
 	/// @param[in] instancer The instancer to be called.
@@ -35,6 +35,21 @@
 
 namespace Rml {
 
+/**
+	Glyph and texture usage of a font engine, see FontEngineInterface::GetAtlasStatistics().
+ */
+struct FontAtlasStatistics
+{
+	// Number of font faces instanced at a given size.
+	int num_font_face_handles = 0;
+	// Number of glyphs generated for all the font face handles.
+	int num_glyphs = 0;
+	// Number of font textures, textures shared between layers are counted once.
+	int num_textures = 0;
+	// Size of the font texture data, in bytes.
+	size_t texture_memory = 0;
+};
+
 /**
 	The abstract base class for an application-specific font engine implementation.
 	
@@ -127,6 +142,16 @@ public:
 	/// @param[in] face_handle The font handle.
 	/// @return The version required for using any geometry generated with the face handle.
 	virtual int GetVersion(FontFaceHandle handle);
+
+	/// Called by the application to generate glyphs ahead of their first use, such as during a loading screen, so that
+	/// showing them later does not stall a frame. The default implementation does nothing.
+	/// @param[in] handle The font handle.
+	/// @param[in] characters The characters to generate, as a UTF-8 string.
+	virtual void PrepareGlyphs(FontFaceHandle handle, const String& characters);
+
+	/// Called by the application to retrieve the glyph and texture usage of the font engine. The default implementation returns empty statistics.
+	/// @return The statistics of all font face handles.
+	virtual FontAtlasStatistics GetAtlasStatistics();
 };
 
 } // namespace Rml
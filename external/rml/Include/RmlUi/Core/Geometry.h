@@ -30,6 +30,7 @@
 #define RMLUI_CORE_GEOMETRY_H
 
 #include "Header.h"
+#include "MemoryInterface.h"
 #include "Vertex.h"
 #include <stdint.h>
 
@@ -70,11 +71,11 @@ public:
 	void Render(Vector2f translation);
 
 	/// Returns the geometry's vertices. If these are written to, Release() should be called to force a recompile.
-	/// @return The geometry's vertex array.
-	Vector< Vertex >& GetVertices();
+	/// @return The geometry's vertex array, allocated through the memory interface.
+	MemoryVector< Vertex >& GetVertices();
 	/// Returns the geometry's indices. If these are written to, Release() should be called to force a recompile.
-	/// @return The geometry's index array.
-	Vector< int >& GetIndices();
+	/// @return The geometry's index array, allocated through the memory interface.
+	MemoryVector< int >& GetIndices();
 
 	/// Gets the geometry's texture.
 	/// @return The geometry's texture.
@@ -99,8 +100,8 @@ private:
 	Context* host_context = nullptr;
 	Element* host_element = nullptr;
 
-	Vector< Vertex > vertices;
-	Vector< int > indices;
+	MemoryVector< Vertex > vertices;
+	MemoryVector< int > indices;
 	const Texture* texture = nullptr;
 
 	CompiledGeometryHandle compiled_geometry = 0;
@@ -0,0 +1,116 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_MEMORYINTERFACE_H
+#define RMLUI_CORE_MEMORYINTERFACE_H
+
+#include "Header.h"
+#include "Types.h"
+#include "Traits.h"
+#include <new>
+#include <type_traits>
+
+namespace Rml {
+
+/**
+	The abstract base class for application-specific memory allocation.
+
+	By default, RmlUi allocates from the heap. Applications with their own memory management can derive this class, and
+	install it through Rml::SetMemoryInterface() before initialising RmlUi. The following are then allocated through
+	this interface:
+	 - The element arenas of documents, from which their elements and element meta data are allocated.
+	 - The chunks of the object pools, such as the pools of detached elements, element meta data, observer blocks and
+	   layout blocks.
+	 - The vertices and indices of geometry.
+	Strings, variants, properties and other containers are still allocated from the heap.
+ */
+
+class RMLUICORE_API MemoryInterface : public NonCopyMoveable
+{
+public:
+	MemoryInterface();
+	virtual ~MemoryInterface();
+
+	/// Allocates a block of memory.
+	/// @param[in] size The number of bytes to allocate.
+	/// @param[in] alignment The required alignment of the block, a power of two.
+	/// @return The allocated block.
+	virtual void* Allocate(size_t size, size_t alignment) = 0;
+	/// Deallocates a block of memory previously allocated through Allocate().
+	/// @param[in] ptr The block to deallocate.
+	virtual void Deallocate(void* ptr) = 0;
+};
+
+// Declared in Core.h, repeated here so that the allocator below does not need the whole core API.
+RMLUICORE_API MemoryInterface* GetMemoryInterface();
+
+/**
+	Standard allocator allocating through the memory interface installed when the allocator was created, or from the
+	heap if there was none. Memory is always returned to where it was allocated from, even if the interface is reset
+	on shutdown.
+ */
+
+template <typename T>
+class MemoryInterfaceAllocator
+{
+public:
+	using value_type = T;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	MemoryInterfaceAllocator() noexcept : memory_interface(GetMemoryInterface()) {}
+	template <class U> MemoryInterfaceAllocator(const MemoryInterfaceAllocator<U>& other) noexcept : memory_interface(other.memory_interface) {}
+
+	T* allocate(size_t num_objects) {
+		const size_t size = num_objects * sizeof(T);
+		if (memory_interface)
+			return static_cast<T*>(memory_interface->Allocate(size, alignof(T)));
+		return static_cast<T*>(::operator new(size));
+	}
+
+	void deallocate(T* ptr, size_t) noexcept {
+		if (memory_interface)
+			memory_interface->Deallocate(ptr);
+		else
+			::operator delete(ptr);
+	}
+
+	MemoryInterface* memory_interface;
+};
+
+template <class T, class U>
+bool operator==(const MemoryInterfaceAllocator<T>& a, const MemoryInterfaceAllocator<U>& b) { return a.memory_interface == b.memory_interface; }
+template <class T, class U>
+bool operator!=(const MemoryInterfaceAllocator<T>& a, const MemoryInterfaceAllocator<U>& b) { return a.memory_interface != b.memory_interface; }
+
+/// A vector of elements allocated through the memory interface.
+template <typename T>
+using MemoryVector = std::vector<T, MemoryInterfaceAllocator<T>>;
+
+} // namespace Rml
+#endif
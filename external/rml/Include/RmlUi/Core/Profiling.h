@@ -55,6 +55,32 @@
 #define RMLUI_FrameMarkStart(name)       FrameMarkStart(name)
 #define RMLUI_FrameMarkEnd(name)         FrameMarkEnd(name)
 
+#elif defined(RMLUI_CUSTOM_PROFILING)
+
+// Zones are forwarded to the application's profiler through the installed ProfilingInterface. Frames are expected to
+// be marked by the application, and plots are not supported.
+#include "ProfilingInterface.h"
+
+#define RMLUI_ZoneNamed(varname, active)                 Rml::ProfilingZone varname(__FUNCTION__, 0, active)
+#define RMLUI_ZoneNamedN(varname, name, active)          Rml::ProfilingZone varname(name, 0, active)
+#define RMLUI_ZoneNamedC(varname, color, active)         Rml::ProfilingZone varname(__FUNCTION__, color, active)
+#define RMLUI_ZoneNamedNC(varname, name, color, active)  Rml::ProfilingZone varname(name, color, active)
+
+#define RMLUI_ZoneScoped                 Rml::ProfilingZone rmlui_profiling_zone(__FUNCTION__, 0)
+#define RMLUI_ZoneScopedN(name)          Rml::ProfilingZone rmlui_profiling_zone(name, 0)
+#define RMLUI_ZoneScopedC(color)         Rml::ProfilingZone rmlui_profiling_zone(__FUNCTION__, color)
+#define RMLUI_ZoneScopedNC(name, color)  Rml::ProfilingZone rmlui_profiling_zone(name, color)
+
+#define RMLUI_ZoneText(txt, size)        rmlui_profiling_zone.Text(txt, size)
+#define RMLUI_ZoneName(txt, size)        rmlui_profiling_zone.Text(txt, size)
+
+#define RMLUI_TracyPlot(name,val)
+
+#define RMLUI_FrameMark
+#define RMLUI_FrameMarkNamed(name)
+#define RMLUI_FrameMarkStart(name)
+#define RMLUI_FrameMarkEnd(name)
+
 #else
 
 #define RMLUI_ZoneNamed(varname, active)
@@ -0,0 +1,84 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_PROFILINGINTERFACE_H
+#define RMLUI_CORE_PROFILINGINTERFACE_H
+
+#include "Header.h"
+#include "Types.h"
+#include "Traits.h"
+#include <stdint.h>
+
+namespace Rml {
+
+/**
+	The abstract base class for forwarding RmlUi's profiling zones to an application-specific profiler.
+
+	Zones are only emitted when the library is built with RMLUI_CUSTOM_PROFILING defined, see Profiling.h. The
+	application installs its interface through Rml::SetProfilingInterface(), zones begun while no interface is set are
+	ignored.
+ */
+
+class RMLUICORE_API ProfilingInterface : public NonCopyMoveable
+{
+public:
+	ProfilingInterface();
+	virtual ~ProfilingInterface();
+
+	/// Called when a zone is entered. Zones are strictly nested on each thread.
+	/// @param[in] name The name of the zone, a string literal which stays valid for the lifetime of the program.
+	/// @param[in] color The color of the zone as 0xRRGGBB, or zero if none was specified.
+	virtual void BeginZone(const char* name, uint32_t color) = 0;
+	/// Called when the innermost zone of the calling thread is left.
+	virtual void EndZone() = 0;
+	/// Attaches text to the innermost zone of the calling thread.
+	/// @param[in] text The text, not necessarily null-terminated. It is only valid during the call.
+	/// @param[in] size The length of the text.
+	virtual void ZoneText(const char* text, size_t size);
+};
+
+/**
+	Scoped profiling zone, used by the RMLUI_Zone macros when building with RMLUI_CUSTOM_PROFILING.
+ */
+
+class RMLUICORE_API ProfilingZone : public NonCopyMoveable
+{
+public:
+	ProfilingZone(const char* name, uint32_t color, bool active = true);
+	~ProfilingZone();
+
+	/// Attaches text to the zone.
+	void Text(const char* text, size_t size);
+
+private:
+	// The interface the zone was begun with, or nullptr if the zone is not recorded.
+	ProfilingInterface* profiling_interface;
+};
+
+} // namespace Rml
+#endif
@@ -112,6 +112,17 @@ public:
 	/// @param[in] transform The new transform to apply, or nullptr if no transform applies to the current element.
 	virtual void SetTransform(const Matrix4f* transform);
 
+	/// Called by RmlUi when it wants the renderer to multiply the alpha of all following geometry by an opacity.
+	/// This lets 'opacity' animations reuse the geometry of their elements instead of regenerating it every frame. It is
+	/// only called if SupportsCompositing() returns true, and the opacity is reset to 1 at the end of each context render.
+	/// @param[in] opacity The opacity to multiply with, in the range [0, 1].
+	virtual void SetOpacity(float opacity);
+	/// Called by RmlUi to determine whether the renderer applies SetTransform() and SetOpacity() to all following
+	/// geometry, including compiled geometry. Only then are 'transform' and 'opacity' animations run without restyling
+	/// their elements and regenerating their geometry every frame.
+	/// @return True if animations may be composited by the renderer, false otherwise.
+	virtual bool SupportsCompositing();
+
 	/// Get the context currently being rendered. This is only valid during RenderGeometry,
 	/// CompileGeometry, RenderCompiledGeometry, EnableScissorRegion and SetScissorRegion.
 	Context* GetContext() const;
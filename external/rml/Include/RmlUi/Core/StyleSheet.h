@@ -74,7 +74,24 @@ class RMLUICORE_API StyleSheet : public NonCopyMoveable
 {
 public:
 	typedef Vector< StyleSheetNode* > NodeList;
-	typedef UnorderedMap< size_t, NodeList > NodeIndex;
+
+	/// Index of the styled nodes, by the id, class or tag of their rightmost selector, in that order of preference.
+	struct NodeIndex {
+		UnorderedMap< String, NodeList > ids;
+		UnorderedMap< String, NodeList > classes;
+		UnorderedMap< String, NodeList > tags;
+		/// Nodes without any id, class or tag requirement.
+		NodeList other;
+
+		/// The class and pseudo class names used by any selector, and the ones used by the ancestor parts of selectors.
+		UnorderedSet< String > class_dependencies;
+		UnorderedSet< String > ancestor_class_dependencies;
+		UnorderedSet< String > pseudo_class_dependencies;
+		UnorderedSet< String > ancestor_pseudo_class_dependencies;
+	};
+
+	/// The element definitions which may change when a class or pseudo class is set or removed on an element.
+	enum class SelectorDependency { None, Self, SelfAndDescendants };
 
 	StyleSheet();
 	virtual ~StyleSheet();
@@ -109,8 +126,10 @@ public:
 	/// caller, so another should not be added. The definition should be released by removing the reference count.
 	SharedPtr<ElementDefinition> GetElementDefinition(const Element* element) const;
 
-	/// Retrieve the hash key used to look-up applicable nodes in the node index.
-	static size_t NodeHash(const String& tag, const String& id);
+	/// Returns the element definitions which may change when the given class is set or removed on an element.
+	SelectorDependency GetClassDependency(const String& class_name) const;
+	/// Returns the element definitions which may change when the given pseudo class is set or removed on an element.
+	SelectorDependency GetPseudoClassDependency(const String& pseudo_class) const;
 
 private:
 	// Root level node, attributes from special nodes like "body" get added to this node
@@ -134,6 +153,7 @@ private:
 
 	// Map of all styled nodes, that is, they have one or more properties.
 	NodeIndex styled_node_index;
+	bool node_index_built = false;
 
 	using ElementDefinitionCache = UnorderedMap< size_t, SharedPtr<ElementDefinition> >;
 	// Index of node sets to element definitions.
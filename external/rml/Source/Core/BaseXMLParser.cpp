@@ -85,6 +85,35 @@ void BaseXMLParser::Parse(Stream* stream)
 }
 
 // Get the current file line number
+void BaseXMLParser::Parse(Stream* stream, XMLRecording& _recording)
+{
+	recording = &_recording;
+	Parse(stream);
+	recording = nullptr;
+}
+
+void BaseXMLParser::Replay(const URL& _source_url, const XMLRecording& _recording)
+{
+	RMLUI_ZoneScoped;
+
+	source_url = &_source_url;
+
+	for (const XMLRecordedEvent& event : _recording)
+	{
+		line_number = event.line_number;
+		line_number_open_tag = event.line_number_open_tag;
+
+		switch (event.type)
+		{
+		case XMLRecordedEvent::Type::ElementStart: HandleElementStart(event.value, event.attributes); break;
+		case XMLRecordedEvent::Type::ElementEnd:   HandleElementEnd(event.value); break;
+		case XMLRecordedEvent::Type::Data:         HandleData(event.value, event.data_type); break;
+		}
+	}
+
+	source_url = nullptr;
+}
+
 int BaseXMLParser::GetLineNumber() const
 {
 	return line_number;
@@ -137,20 +166,53 @@ char BaseXMLParser::Look() const {
 
 void BaseXMLParser::HandleElementStartInternal(const String& name, const XMLAttributes& attributes)
 {
-	if (!inner_xml_data)
-		HandleElementStart(name, attributes);
+	if (inner_xml_data)
+		return;
+
+	if (recording)
+	{
+		XMLRecordedEvent event = RecordEvent(XMLRecordedEvent::Type::ElementStart, name);
+		event.attributes = attributes;
+		recording->push_back(std::move(event));
+	}
+
+	HandleElementStart(name, attributes);
 }
 
 void BaseXMLParser::HandleElementEndInternal(const String& name)
 {
-	if (!inner_xml_data)
-		HandleElementEnd(name);
+	if (inner_xml_data)
+		return;
+
+	if (recording)
+		recording->push_back(RecordEvent(XMLRecordedEvent::Type::ElementEnd, name));
+
+	HandleElementEnd(name);
 }
 
 void BaseXMLParser::HandleDataInternal(const String& data, XMLDataType type)
 {
-	if (!inner_xml_data)
-		HandleData(data, type);
+	if (inner_xml_data)
+		return;
+
+	if (recording)
+	{
+		XMLRecordedEvent event = RecordEvent(XMLRecordedEvent::Type::Data, data);
+		event.data_type = type;
+		recording->push_back(std::move(event));
+	}
+
+	HandleData(data, type);
+}
+
+XMLRecordedEvent BaseXMLParser::RecordEvent(XMLRecordedEvent::Type type, const String& value) const
+{
+	XMLRecordedEvent event;
+	event.type = type;
+	event.line_number = line_number;
+	event.line_number_open_tag = line_number_open_tag;
+	event.value = value;
+	return event;
 }
 
 void BaseXMLParser::ReadHeader()
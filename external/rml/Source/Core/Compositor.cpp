@@ -0,0 +1,194 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "Compositor.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/RenderInterface.h"
+#include "ElementStyle.h"
+#include <algorithm>
+
+namespace Rml {
+
+bool Compositor::CanComposite(PropertyId id, RenderInterface* render_interface)
+{
+	if (id != PropertyId::Transform && id != PropertyId::Opacity)
+		return false;
+	return render_interface && render_interface->SupportsCompositing();
+}
+
+void Compositor::AddAnimation(Element* element, ElementAnimation&& animation, const Property& value)
+{
+	RMLUI_ASSERT(!animation.IsComplete());
+
+	const PropertyId id = animation.GetPropertyId();
+	if (id == PropertyId::Opacity)
+	{
+		// The geometry is regenerated once at full opacity, the animated opacity is applied while rendering.
+		element->SetProperty(PropertyId::Opacity, Property(1.0f, Property::NUMBER));
+		num_opacity_entries++;
+	}
+	else
+	{
+		element->DirtyTransformState(false, true);
+	}
+
+	entries.push_back(Entry{ element, std::move(animation), value });
+	element->composited_animations = true;
+}
+
+void Compositor::ReturnAnimations(Element* element)
+{
+	if (!element->composited_animations)
+		return;
+
+	for (size_t i = entries.size(); i-- > 0;)
+	{
+		if (entries[i].element == element)
+			ReturnAnimation(i);
+	}
+}
+
+void Compositor::ReturnDocumentAnimations(ElementDocument* document)
+{
+	for (size_t i = entries.size(); i-- > 0;)
+	{
+		if (entries[i].element->GetOwnerDocument() == document)
+			ReturnAnimation(i);
+	}
+}
+
+bool Compositor::Update(double time)
+{
+	if (entries.empty())
+		return false;
+
+	RMLUI_ZoneScoped;
+
+	for (Entry& entry : entries)
+	{
+		Property property = entry.animation.UpdateAndGetProperty(time, *entry.element);
+		if (property.unit == Property::UNKNOWN)
+			continue;
+
+		entry.value = std::move(property);
+		if (entry.animation.GetPropertyId() == PropertyId::Transform)
+		{
+			entry.element->DirtyTransformState(false, true);
+		}
+		else
+		{
+			// Regular animations overwrite the property every frame, so an opacity set in the meantime is replaced as well
+			// instead of being baked into the geometry in addition to the composited value.
+			const Property* local_opacity = entry.element->GetLocalProperty(PropertyId::Opacity);
+			if (!local_opacity || local_opacity->Get<float>() != 1.f)
+				entry.element->SetProperty(PropertyId::Opacity, Property(1.0f, Property::NUMBER));
+		}
+	}
+
+	// Completed animations are handed back with their final value, their elements then remove them and dispatch the end
+	// events as usual.
+	for (size_t i = entries.size(); i-- > 0;)
+	{
+		if (entries[i].animation.IsComplete())
+			ReturnAnimation(i);
+	}
+
+	return true;
+}
+
+const Property* Compositor::GetProperty(const Element* element, PropertyId id) const
+{
+	for (const Entry& entry : entries)
+	{
+		if (entry.element == element && entry.animation.GetPropertyId() == id)
+			return &entry.value;
+	}
+	return nullptr;
+}
+
+void Compositor::ApplyOpacity(const Element& element, RenderInterface* render_interface)
+{
+	if (num_opacity_entries == 0)
+		return;
+
+	// Find the element the opacity is inherited from. Elements with their own opacity have it baked into their geometry.
+	float opacity = 1.f;
+	for (const Element* ancestor = &element; ancestor; ancestor = ancestor->GetParentNode())
+	{
+		if (ancestor->composited_animations)
+		{
+			if (const Property* property = GetProperty(ancestor, PropertyId::Opacity))
+			{
+				// Tweens may overshoot, opacity is only meaningful in the unit range.
+				opacity = Math::Clamp(property->Get<float>(), 0.f, 1.f);
+				break;
+			}
+		}
+
+		if (ancestor->GetStyle()->GetLocalProperty(PropertyId::Opacity))
+			break;
+	}
+
+	if (opacity != submitted_opacity)
+	{
+		render_interface->SetOpacity(opacity);
+		submitted_opacity = opacity;
+	}
+}
+
+void Compositor::EndRender(RenderInterface* render_interface)
+{
+	if (submitted_opacity != 1.f)
+	{
+		render_interface->SetOpacity(1.f);
+		submitted_opacity = 1.f;
+	}
+}
+
+void Compositor::ReturnAnimation(size_t index)
+{
+	Element* element = entries[index].element;
+	const PropertyId id = entries[index].animation.GetPropertyId();
+
+	// Continuing from the animated value restyles the element as if the compositor had never run the animation.
+	element->SetProperty(id, entries[index].value);
+	element->animations.push_back(std::move(entries[index].animation));
+
+	if (id == PropertyId::Opacity)
+		num_opacity_entries--;
+
+	if (index + 1 != entries.size())
+		entries[index] = std::move(entries.back());
+	entries.pop_back();
+
+	element->composited_animations = std::any_of(entries.begin(), entries.end(), [element](const Entry& entry) { return entry.element == element; });
+}
+
+} // namespace Rml
@@ -0,0 +1,100 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_COMPOSITOR_H
+#define RMLUI_CORE_COMPOSITOR_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include "ElementAnimation.h"
+
+namespace Rml {
+
+class Element;
+class ElementDocument;
+class RenderInterface;
+
+/**
+	Runs the animations of a context which only change 'transform' or 'opacity', without restyling their elements or
+	regenerating any geometry.
+
+	Elements hand such animations over while advancing them. The animated transform replaces the computed one in the
+	element's transform state. The geometry of an element with an animated opacity, and of the descendants inheriting
+	it, is generated once at full opacity when the animation is handed over, and the animated opacity is submitted to the
+	render interface as a multiplier when rendering them. The animated values are not part of the elements' computed
+	values, but are returned from Element::GetProperty(). Animations are handed back when they complete, when their
+	element starts other animations or transitions, and when it leaves the context.
+ */
+
+class Compositor : public NonCopyMoveable
+{
+public:
+	/// Returns true if animations of the property can be run by the compositor.
+	/// @param[in] id The animated property.
+	/// @param[in] render_interface The render interface of the element's context, it needs to support compositing.
+	static bool CanComposite(PropertyId id, RenderInterface* render_interface);
+
+	/// Takes over an animation from its element.
+	/// @param[in] element The animated element.
+	/// @param[in] animation The animation, which must not be complete.
+	/// @param[in] value The value the animation evaluated to this frame.
+	void AddAnimation(Element* element, ElementAnimation&& animation, const Property& value);
+
+	/// Hands all animations of the element back to it, setting their current values on it.
+	void ReturnAnimations(Element* element);
+	/// Hands the animations of all elements in the document back to them.
+	void ReturnDocumentAnimations(ElementDocument* document);
+
+	/// Advances all animations, and hands back the ones which completed.
+	/// @return True if any animated value may have changed.
+	bool Update(double time);
+
+	/// Returns the animated value of the element's property, or nullptr if the compositor does not animate it.
+	const Property* GetProperty(const Element* element, PropertyId id) const;
+
+	/// Submits the opacity to multiply the element's geometry with, call before rendering it.
+	void ApplyOpacity(const Element& element, RenderInterface* render_interface);
+	/// Resets the submitted opacity, call after rendering the context.
+	void EndRender(RenderInterface* render_interface);
+
+private:
+	struct Entry {
+		Element* element;
+		ElementAnimation animation;
+		Property value;
+	};
+
+	void ReturnAnimation(size_t index);
+
+	Vector<Entry> entries;
+	int num_opacity_entries = 0;
+	float submitted_opacity = 1.f;
+};
+
+} // namespace Rml
+#endif
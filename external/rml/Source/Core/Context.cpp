@@ -38,9 +38,15 @@
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/DataModel.h"
 #include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "Clock.h"
+#include "Compositor.h"
+#include "ElementArena.h"
 #include "EventDispatcher.h"
+#include "HitTestGrid.h"
+#include "LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "StreamFile.h"
+#include "TextureResource.h"
 #include <algorithm>
 #include <iterator>
 
@@ -85,6 +91,8 @@ Context::Context(const String& name) : name(name), dimensions(0, 0), density_ind
 	last_click_element = nullptr;
 	last_click_time = 0;
 	last_click_mouse_position = Vector2i(0, 0);
+
+	compositor = MakeUnique<Compositor>();
 }
 
 Context::~Context()
@@ -116,8 +124,10 @@ void Context::SetDimensions(const Vector2i& _dimensions)
 	if (dimensions != _dimensions)
 	{
 		dimensions = _dimensions;
+		render_dirty = true;
 		root->SetBox(Box(Vector2f((float) dimensions.x, (float) dimensions.y)));
 		root->DirtyLayout();
+		DirtyHitTestGrid();
 
 		for (int i = 0; i < root->GetNumChildren(); ++i)
 		{
@@ -167,15 +177,32 @@ bool Context::Update()
 {
 	RMLUI_ZoneScoped;
 
+	SystemInterface* system_interface = GetSystemInterface();
+	const double update_begin = system_interface->GetElapsedTime();
+
+	// Composited animations are advanced first, so that the final values of the completed ones are styled in this update.
+	if (compositor->Update(Clock::GetElapsedTime()))
+		render_dirty = true;
+
 	root->Update(density_independent_pixel_ratio);
 
+	const double layout_begin = system_interface->GetElapsedTime();
+	num_layout_roots = 0;
+	LayoutEngine::ResetNumFormattedElements();
+
 	for (int i = 0; i < root->GetNumChildren(); ++i)
 		if (auto doc = root->GetChild(i)->GetOwnerDocument())
 		{
-			doc->UpdateLayout();
+			num_layout_roots += doc->UpdateLayout();
 			doc->UpdatePosition();
 		}
 
+	num_layout_elements = LayoutEngine::ResetNumFormattedElements();
+
+	const double update_end = system_interface->GetElapsedTime();
+	style_update_time = layout_begin - update_begin;
+	layout_update_time = update_end - layout_begin;
+
 	// Release any documents that were unloaded during the update.
 	ReleaseUnloadedDocuments();
 
@@ -191,6 +218,9 @@ bool Context::Render()
 	if (render_interface == nullptr)
 		return false;
 
+	render_dirty = false;
+	render_texture_version = TextureResource::GetReleaseVersion();
+
 	render_interface->context = this;
 	ElementUtilities::ApplyActiveClipRegion(this, render_interface);
 
@@ -208,11 +238,67 @@ bool Context::Render()
 		cursor_proxy->Render();
 	}
 
+	compositor->EndRender(render_interface);
+
 	render_interface->context = nullptr;
 
 	return true;
 }
 
+bool Context::IsRenderDirty() const
+{
+	return render_dirty || render_texture_version != TextureResource::GetReleaseVersion();
+}
+
+int Context::GetNumLayoutRoots() const
+{
+	return num_layout_roots;
+}
+
+int Context::GetNumLayoutElements() const
+{
+	return num_layout_elements;
+}
+
+double Context::GetStyleUpdateTime() const
+{
+	return style_update_time;
+}
+
+double Context::GetLayoutUpdateTime() const
+{
+	return layout_update_time;
+}
+
+size_t Context::GetNumElementArenaBytes() const
+{
+	size_t result = 0;
+	for (int i = 0; i < root->GetNumChildren(); ++i)
+	{
+		ElementDocument* document = root->GetChild(i)->GetOwnerDocument();
+		if (document && document->arena)
+			result += document->arena->GetNumLiveBytes();
+	}
+	return result;
+}
+
+int Context::GetNumElementArenaAllocations() const
+{
+	int result = 0;
+	for (int i = 0; i < root->GetNumChildren(); ++i)
+	{
+		ElementDocument* document = root->GetChild(i)->GetOwnerDocument();
+		if (document && document->arena)
+			result += document->arena->GetNumLiveAllocations();
+	}
+	return result;
+}
+
+void Context::SetRenderDirty()
+{
+	render_dirty = true;
+}
+
 // Creates a new, empty document and places it into this context. 
 ElementDocument* Context::CreateDocument(const String& instancer_name)
 {
@@ -232,6 +318,7 @@ ElementDocument* Context::CreateDocument(const String& instancer_name)
 
 	document->context = this;
 	root->AppendChild(std::move(element));
+	DirtyHitTestGrid();
 
 	PluginRegistry::NotifyDocumentLoad(document);
 
@@ -263,6 +350,7 @@ ElementDocument* Context::LoadDocument(Stream* stream)
 	ElementDocument* document = static_cast<ElementDocument*>(element.get());
 	
 	root->AppendChild(std::move(element));
+	DirtyHitTestGrid();
 
 	ElementUtilities::BindEventAttributes(document);
 
@@ -303,6 +391,7 @@ void Context::UnloadDocument(ElementDocument* _document)
 	}
 
 	ElementDocument* document = _document;
+	render_dirty = true;
 
 	if (document->GetParentNode() == root.get())
 	{
@@ -312,6 +401,10 @@ void Context::UnloadDocument(ElementDocument* _document)
 
 		// Move document to a temporary location to be released later.
 		unloaded_documents.push_back( root->RemoveChild(document) );
+		DirtyHitTestGrid();
+
+		// The elements of the document are released without being detached one by one.
+		compositor->ReturnDocumentAnimations(document);
 	}
 
 	// Remove the item from the focus history.
@@ -400,6 +493,19 @@ int Context::GetNumDocuments() const
 	return root->GetNumChildren();
 }
 
+// Forces the layout and decorators of all documents to be regenerated.
+void Context::DirtyLayoutAndDecorators()
+{
+	for (int i = 0; i < GetNumDocuments(); i++)
+	{
+		ElementDocument* document = GetDocument(i);
+		document->DirtyLayout();
+		document->DirtyDecoratorsRecursive();
+	}
+
+	render_dirty = true;
+}
+
 // Returns the hover element.
 Element* Context::GetHoverElement()
 {
@@ -434,6 +540,7 @@ void Context::PullDocumentToFront(ElementDocument* document)
 				root->children.insert(root->children.begin() + root->GetNumChildren(), std::move(element));
 
 				root->DirtyStackingContext();
+				DirtyHitTestGrid();
 			}
 		}
 	}
@@ -454,6 +561,7 @@ void Context::PushDocumentToBack(ElementDocument* document)
 				root->children.insert(root->children.begin(), std::move(element));
 
 				root->DirtyStackingContext();
+				DirtyHitTestGrid();
 			}
 		}
 	}
@@ -484,6 +592,9 @@ void Context::RemoveEventListener(const String& event, EventListener* listener,
 // Sends a key down event into RmlUi.
 bool Context::ProcessKeyDown(Input::KeyIdentifier key_identifier, int key_modifier_state)
 {
+	// Keys may move carets and selections of text controls, which is not reflected in any properties.
+	render_dirty = true;
+
 	// Generate the parameters for the key event.
 	Dictionary parameters;
 	GenerateKeyEventParameters(parameters, key_identifier);
@@ -528,6 +639,8 @@ bool Context::ProcessTextInput(Character character)
 // Sends a string of text as text input into RmlUi.
 bool Context::ProcessTextInput(const String& string)
 {
+	render_dirty = true;
+
 	Element* target = (focus ? focus : root.get());
 
 	Dictionary parameters;
@@ -546,6 +659,10 @@ bool Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 	bool mouse_moved = (x != mouse_position.x) || (y != mouse_position.y);
 	if (mouse_moved)
 	{
+		// Hovering is reflected in properties, but text selection and dragged elements follow the mouse directly.
+		if (active || drag)
+			render_dirty = true;
+
 		mouse_position.x = x;
 		mouse_position.y = y;
 	}
@@ -597,6 +714,8 @@ static Element* FindFocusElement(Element* element)
 // Sends a mouse-button down event into RmlUi.
 bool Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 {
+	render_dirty = true;
+
 	Dictionary parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
@@ -687,6 +806,8 @@ bool Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 // Sends a mouse-button up event into RmlUi.
 bool Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 {
+	render_dirty = true;
+
 	Dictionary parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
@@ -763,6 +884,8 @@ bool Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 // Sends a mouse-wheel movement event into RmlUi.
 bool Context::ProcessMouseWheel(float wheel_delta, int key_modifier_state)
 {
+	render_dirty = true;
+
 	if (hover)
 	{
 		Dictionary scroll_parameters;
@@ -858,6 +981,8 @@ bool Context::RemoveDataModel(const String& name)
 // Internal callback for when an element is removed from the hierarchy.
 void Context::OnElementDetach(Element* element)
 {
+	compositor->ReturnAnimations(element);
+
 	auto it_hover = hover_chain.find(element);
 	if (it_hover != hover_chain.end())
 	{
@@ -1088,6 +1213,16 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 			return nullptr;
 
 		element = root.get();
+
+		// The grid tests the same elements in the same order as the traversal below, but only those near the point.
+		if (UseHitTestGrid())
+		{
+			ElementDocument* modal_document = (focus ? focus->GetOwnerDocument() : nullptr);
+			if (modal_document && !modal_document->IsModal())
+				modal_document = nullptr;
+
+			return hit_test_grid->GetElementAtPoint(point, modal_document, ignore_element);
+		}
 	}
 
 	// Check if any documents have modal focus; if so, only check down than document.
@@ -1135,31 +1270,37 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 		}
 	}
 
-	// Ignore elements whose pointer events are disabled.
-	if (element->GetComputedValues().pointer_events == Style::PointerEvents::None)
-		return nullptr;
+	// Check if the point is actually within this element.
+	if (HitTestGrid::IsPointWithinElement(element, point))
+		return element;
+
+	return nullptr;
+}
 
-	// Projection may fail if we have a singular transformation matrix.
-	bool projection_result = element->Project(point);
+void Context::DirtyHitTestGrid()
+{
+	hit_test_grid_dirty = true;
+	num_hit_tests_while_dirty = 0;
+}
 
-	// Check if the point is actually within this element.
-	bool within_element = (projection_result && element->IsPointWithinElement(point));
-	if (within_element)
+bool Context::UseHitTestGrid() const
+{
+	if (hit_test_grid_dirty)
 	{
-		Vector2i clip_origin, clip_dimensions;
-		if (ElementUtilities::GetClippingRegion(clip_origin, clip_dimensions, element))
-		{
-			within_element = point.x >= clip_origin.x &&
-							 point.y >= clip_origin.y &&
-							 point.x <= (clip_origin.x + clip_dimensions.x) &&
-							 point.y <= (clip_origin.y + clip_dimensions.y);
-		}
-	}
+		// Building the grid costs more than walking the element tree once, so the first query after a change walks the
+		// tree. The grid is only built once more queries follow before the next change.
+		if (num_hit_tests_while_dirty++ == 0)
+			return false;
 
-	if (within_element)
-		return element;
+		if (!hit_test_grid)
+			hit_test_grid = MakeUnique<HitTestGrid>();
 
-	return nullptr;
+		hit_test_grid->Build(root.get(), dimensions);
+		hit_test_grid_dirty = false;
+		num_hit_tests_while_dirty = 0;
+	}
+
+	return true;
 }
 
 // Creates the drag clone from the given element.
@@ -28,11 +28,53 @@
 
 #include "../../Include/RmlUi/Core/ConvolutionFilter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include <algorithm>
 #include <float.h>
 #include <string.h>
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define RMLUI_CONVOLUTION_FILTER_SSE
+	#include <xmmintrin.h>
+#endif
+
 namespace Rml {
 
+// Combines 'count' weighted source opacities into the accumulated opacities, four at a time when SSE is available.
+template <FilterOperation Operation>
+static inline void AccumulateRow(float* accumulator, const float* source, const float weight, const int count)
+{
+	int i = 0;
+
+#ifdef RMLUI_CONVOLUTION_FILTER_SSE
+	const __m128 weight4 = _mm_set1_ps(weight);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 opacity = _mm_mul_ps(_mm_loadu_ps(source + i), weight4);
+		const __m128 accumulated = _mm_loadu_ps(accumulator + i);
+
+		switch (Operation)
+		{
+		case FilterOperation::Sum:      _mm_storeu_ps(accumulator + i, _mm_add_ps(accumulated, opacity)); break;
+		case FilterOperation::Dilation: _mm_storeu_ps(accumulator + i, _mm_max_ps(accumulated, opacity)); break;
+		case FilterOperation::Erosion:  _mm_storeu_ps(accumulator + i, _mm_min_ps(accumulated, opacity)); break;
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const float opacity = source[i] * weight;
+
+		switch (Operation)
+		{
+		case FilterOperation::Sum:      accumulator[i] += opacity; break;
+		case FilterOperation::Dilation: accumulator[i] = Math::Max(accumulator[i], opacity); break;
+		case FilterOperation::Erosion:  accumulator[i] = Math::Min(accumulator[i], opacity); break;
+		}
+	}
+}
+
 ConvolutionFilter::ConvolutionFilter()
 {}
 
@@ -74,52 +116,82 @@ void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimens
 {
 	RMLUI_ZoneScopedNC("ConvFilter::Run", 0xd6bf49);
 
-	const float initial_opacity = (operation == FilterOperation::Erosion ? FLT_MAX : 0.f);
+	if (destination_dimensions.x <= 0 || destination_dimensions.y <= 0)
+		return;
 
 	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
 
+	// Copy the source opacities into a zero-padded buffer which covers every kernel tap of every destination pixel,
+	// so that the destination pixel (x, y) with the kernel tap (kernel_x, kernel_y) reads padded[y + kernel_y][x + kernel_x].
+	const Vector2i padded_dimensions = destination_dimensions + kernel_size - Vector2i(1);
+	const Vector2i padded_origin = source_offset + kernel_radius;
+
+	thread_local Vector<float> padded;
+	thread_local Vector<float> accumulator;
+	padded.assign(size_t(padded_dimensions.x * padded_dimensions.y), 0.f);
+	accumulator.resize(size_t(destination_dimensions.x));
+
+	const int copy_begin_x = Math::Max(0, -padded_origin.x);
+	const int copy_end_x = Math::Min(source_dimensions.x, padded_dimensions.x - padded_origin.x);
+	const int copy_begin_y = Math::Max(0, -padded_origin.y);
+	const int copy_end_y = Math::Min(source_dimensions.y, padded_dimensions.y - padded_origin.y);
+
+	for (int source_y = copy_begin_y; source_y < copy_end_y; ++source_y)
+	{
+		const byte* source_row = source + source_y * source_dimensions.x;
+		float* padded_row = padded.data() + (source_y + padded_origin.y) * padded_dimensions.x + padded_origin.x;
+
+		for (int source_x = copy_begin_x; source_x < copy_end_x; ++source_x)
+			padded_row[source_x] = float(source_row[source_x]);
+	}
+
+	switch (operation)
+	{
+	case FilterOperation::Sum:      RunRows<FilterOperation::Sum>(destination, destination_dimensions, destination_stride, destination_color_format, padded.data(), padded_dimensions.x, accumulator.data()); break;
+	case FilterOperation::Dilation: RunRows<FilterOperation::Dilation>(destination, destination_dimensions, destination_stride, destination_color_format, padded.data(), padded_dimensions.x, accumulator.data()); break;
+	case FilterOperation::Erosion:  RunRows<FilterOperation::Erosion>(destination, destination_dimensions, destination_stride, destination_color_format, padded.data(), padded_dimensions.x, accumulator.data()); break;
+	}
+}
+
+template <FilterOperation Operation>
+void ConvolutionFilter::RunRows(byte* destination, const Vector2i destination_dimensions, const int destination_stride, const ColorFormat destination_color_format, const float* padded, const int padded_stride, float* accumulator) const
+{
+	const float initial_opacity = (Operation == FilterOperation::Erosion ? FLT_MAX : 0.f);
+	const int width = destination_dimensions.x;
+
 	for (int y = 0; y < destination_dimensions.y; ++y)
 	{
-		for (int x = 0; x < destination_dimensions.x; ++x)
+		std::fill(accumulator, accumulator + width, initial_opacity);
+
+		// Each kernel tap is applied to a whole row at a time, which lets us vectorize across the destination pixels.
+		for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
 		{
-			float opacity = initial_opacity;
+			const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+			const float* padded_row = padded + (y + kernel_y) * padded_stride;
 
-			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
 			{
-				int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
-
-				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
-				{
-					float pixel_opacity;
-
-					int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
-					if (source_y >= 0 && source_y < source_dimensions.y &&
-						source_x >= 0 && source_x < source_dimensions.x)
-					{
-						pixel_opacity = float(source[source_y * source_dimensions.x + source_x]) * kernel[kernel_y * kernel_size.x + kernel_x];
-					}
-					else
-						pixel_opacity = 0;
-
-					switch (operation)
-					{
-					case FilterOperation::Sum:      opacity += pixel_opacity; break;
-					case FilterOperation::Dilation: opacity = Math::Max(opacity, pixel_opacity); break;
-					case FilterOperation::Erosion:  opacity = Math::Min(opacity, pixel_opacity); break;
-					}
-				}
-			}
+				const float weight = kernel_row[kernel_x];
 
-			opacity = Math::Min(255.f, opacity);
+				// Zero-weighted taps do not contribute to sums, nor to dilations since opacities are never negative. This
+				// makes e.g. the horizontal and vertical passes of separable filters as cheap as their non-zero taps.
+				if (weight == 0.f && Operation != FilterOperation::Erosion)
+					continue;
 
-			int destination_index = 0;
-			switch (destination_color_format)
-			{
-			case ColorFormat::RGBA8: destination_index = x * 4 + 3; break;
-			case ColorFormat::A8:    destination_index = x; break;
+				AccumulateRow<Operation>(accumulator, padded_row + kernel_x, weight, width);
 			}
+		}
 
-			destination[destination_index] = byte(opacity);
+		switch (destination_color_format)
+		{
+		case ColorFormat::RGBA8:
+			for (int x = 0; x < width; ++x)
+				destination[x * 4 + 3] = byte(Math::Min(255.f, accumulator[x]));
+			break;
+		case ColorFormat::A8:
+			for (int x = 0; x < width; ++x)
+				destination[x] = byte(Math::Min(255.f, accumulator[x]));
+			break;
 		}
 
 		destination += destination_stride;
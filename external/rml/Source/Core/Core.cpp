@@ -41,6 +41,7 @@
 #include "FileInterfaceDefault.h"
 #include "GeometryDatabase.h"
 #include "PluginRegistry.h"
+#include "Pool.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetParser.h"
 #include "TemplateCache.h"
@@ -62,6 +63,10 @@ static SystemInterface* system_interface = nullptr;
 static FileInterface* file_interface = nullptr;
 // RmlUi's font engine interface.
 static FontEngineInterface* font_interface = nullptr;
+// RmlUi's memory interface.
+static MemoryInterface* memory_interface = nullptr;
+// RmlUi's profiling interface.
+static ProfilingInterface* profiling_interface = nullptr;
 
 // Default interfaces should be created and destroyed on Initialise and Shutdown, respectively.
 static UniquePtr<FileInterface> default_file_interface;
@@ -153,11 +158,16 @@ void Shutdown()
 
 	TextureDatabase::Shutdown();
 
+	// Everything allocated from the pools has been released by now, return their chunks while the memory interface is alive.
+	PoolBase::ReleaseUnusedPools();
+
 	initialised = false;
 
 	render_interface = nullptr;
 	file_interface = nullptr;
 	system_interface = nullptr;
+	memory_interface = nullptr;
+	profiling_interface = nullptr;
 
 	default_file_interface.reset();
 
@@ -218,6 +228,30 @@ FontEngineInterface* GetFontEngineInterface()
 	return font_interface;
 }
 
+// Sets the interface through which the element arenas, object pools and geometry allocate their memory.
+void SetMemoryInterface(MemoryInterface* _memory_interface)
+{
+	memory_interface = _memory_interface;
+}
+
+// Returns RmlUi's memory interface.
+MemoryInterface* GetMemoryInterface()
+{
+	return memory_interface;
+}
+
+// Sets the interface receiving the profiling zones.
+void SetProfilingInterface(ProfilingInterface* _profiling_interface)
+{
+	profiling_interface = _profiling_interface;
+}
+
+// Returns RmlUi's profiling interface.
+ProfilingInterface* GetProfilingInterface()
+{
+	return profiling_interface;
+}
+
 // Creates a new element context.
 Context* CreateContext(const String& name, const Vector2i& dimensions, RenderInterface* custom_render_interface)
 {
@@ -336,9 +370,21 @@ StringList GetTextureSourceList()
 	return TextureDatabase::GetSourceList();
 }
 
-void ReleaseTextures()
+void ReleaseTextures(RenderInterface* render_interface)
 {
-	TextureDatabase::ReleaseTextures();
+	TextureDatabase::ReleaseTextures(render_interface);
+
+	// The style sheets of cached documents hold decorators which reference the released textures.
+	Factory::ClearDocumentCache();
+}
+
+void ReleaseTexture(const String& source)
+{
+	if (!TextureDatabase::ReleaseTexture(source))
+		return;
+
+	for (auto& context : contexts)
+		context.second->DirtyLayoutAndDecorators();
 }
 
 void ReleaseCompiledGeometry()
@@ -972,6 +972,421 @@ private:
 };
 
 
+/*
+	Compiled programs for expressions which are run repeatedly, such as data views evaluated on every model update.
+
+	Compilation folds literal sub-expressions into single literals. The registers and stack of the compiled machine
+	hold numbers and booleans directly, and only use Variants for strings, variables and transform function values.
+	Thus, arithmetic and comparisons neither construct Variants nor convert between them. Variables which stay at
+	the same location for the lifetime of the data model are resolved once, instead of looking up their address on
+	every run. Programs which modify the data model (assignments and event callbacks) are not compiled, they are
+	only run once per event and use the interpreter above.
+*/
+struct TypedValue {
+	enum class Type : uint8_t { Number, Bool, Variant };
+
+	Type type = Type::Variant;
+	bool boolean = false;
+	double number = 0.0;
+	Variant variant;
+
+	void SetNumber(double value) {
+		type = Type::Number;
+		number = value;
+	}
+	void SetBool(bool value) {
+		type = Type::Bool;
+		boolean = value;
+	}
+	void SetVariant(const Variant& value) {
+		type = Type::Variant;
+		variant = value;
+	}
+	void Assign(const TypedValue& other) {
+		type = other.type;
+		boolean = other.boolean;
+		number = other.number;
+		if (type == Type::Variant)
+			variant = other.variant;
+	}
+
+	// The conversions below match those of the interpreter, which operates on Variants throughout.
+	double GetNumber() const {
+		switch (type) {
+		case Type::Number:  return number;
+		case Type::Bool:    return boolean ? 1.0 : 0.0;
+		case Type::Variant: return variant.Get<double>();
+		}
+		return 0.0;
+	}
+	bool GetBool() const {
+		switch (type) {
+		case Type::Number:  return number != 0.0;
+		case Type::Bool:    return boolean;
+		case Type::Variant: return variant.Get<bool>();
+		}
+		return false;
+	}
+	bool IsString() const {
+		return type == Type::Variant && variant.GetType() == Variant::STRING;
+	}
+	String GetString() const {
+		return type == Type::Variant ? variant.Get<String>() : ToVariant().Get<String>();
+	}
+	Variant ToVariant() const {
+		switch (type) {
+		case Type::Number:  return Variant(number);
+		case Type::Bool:    return Variant(boolean);
+		case Type::Variant: return variant;
+		}
+		return Variant();
+	}
+
+	static TypedValue FromVariant(const Variant& value) {
+		TypedValue result;
+		if (value.GetType() == Variant::DOUBLE)
+			result.SetNumber(value.Get<double>());
+		else if (value.GetType() == Variant::BOOL)
+			result.SetBool(value.Get<bool>());
+		else
+			result.SetVariant(value);
+		return result;
+	}
+};
+
+struct CompiledInstruction {
+	Instruction instruction;
+	// Register for Pop, index into the literals for Literal, variables for Variable, function names for TransformFnc,
+	// and number of arguments for Arguments.
+	int data;
+};
+
+struct CompiledProgram {
+	Vector<CompiledInstruction> instructions;
+	Vector<TypedValue> literals;
+	Vector<String> function_names;
+
+	// Resolved variables, parallel to the expression's address list. Empty variables are looked up on every run.
+	Vector<DataVariable> variables;
+
+	// Scratch space for running the program, sized to the deepest stack use of the program.
+	Vector<TypedValue> stack;
+	VariantList arguments;
+};
+
+namespace Compile {
+
+	// Returns the number of instructions starting at 'i' which only operate on literals, and can be replaced by their result.
+	static size_t ConstantSequenceLength(const Program& program, size_t i)
+	{
+		auto IsInstruction = [&program](size_t index, Instruction instruction) {
+			return index < program.size() && program[index].instruction == instruction;
+		};
+		auto IsPop = [&program](size_t index, Register destination) {
+			return index < program.size() && program[index].instruction == Instruction::Pop && program[index].data.Get<int>(-1) == int(destination);
+		};
+
+		if (!IsInstruction(i, Instruction::Literal))
+			return 0;
+
+		// R = !D
+		if (IsInstruction(i + 1, Instruction::Not))
+			return 2;
+
+		// R = D; S+ = R; R = D; L = S-; R = L <op> R
+		if (IsInstruction(i + 1, Instruction::Push) && IsInstruction(i + 2, Instruction::Literal) && IsPop(i + 3, Register::L) && i + 4 < program.size())
+		{
+			switch (program[i + 4].instruction)
+			{
+			case Instruction::Add:
+			case Instruction::Subtract:
+			case Instruction::Multiply:
+			case Instruction::Divide:
+			case Instruction::And:
+			case Instruction::Or:
+			case Instruction::Less:
+			case Instruction::LessEq:
+			case Instruction::Greater:
+			case Instruction::GreaterEq:
+			case Instruction::Equal:
+			case Instruction::NotEqual:
+				return 5;
+			default:
+				break;
+			}
+		}
+
+		// R = D; S+ = R; R = D; S+ = R; R = D; C = S-; L = S-; R = L ? C : R
+		if (IsInstruction(i + 1, Instruction::Push) && IsInstruction(i + 2, Instruction::Literal) && IsInstruction(i + 3, Instruction::Push) &&
+			IsInstruction(i + 4, Instruction::Literal) && IsPop(i + 5, Register::C) && IsPop(i + 6, Register::L) && IsInstruction(i + 7, Instruction::Ternary))
+			return 8;
+
+		return 0;
+	}
+
+	// Replaces sequences operating only on literals by their result, repeatedly, until no more sequences can be folded.
+	// The sequences are self-contained: they balance their stack operations, and only leave their result in R.
+	static void FoldConstants(Program& program)
+	{
+		const AddressList no_addresses;
+		bool folded = true;
+
+		while (folded)
+		{
+			folded = false;
+			for (size_t i = 0; i < program.size(); i++)
+			{
+				const size_t length = ConstantSequenceLength(program, i);
+				if (length == 0)
+					continue;
+
+				const Program sequence(program.begin() + i, program.begin() + i + length);
+				DataInterpreter interpreter(sequence, no_addresses, DataExpressionInterface());
+				if (!interpreter.Run())
+					continue;
+
+				program[i] = InstructionData{ Instruction::Literal, interpreter.Result() };
+				program.erase(program.begin() + i + 1, program.begin() + i + length);
+				folded = true;
+			}
+		}
+	}
+
+	static UniquePtr<CompiledProgram> Build(const Program& source_program, const AddressList& addresses, const DataExpressionInterface& expression_interface)
+	{
+		Program program = source_program;
+		FoldConstants(program);
+
+		auto compiled = MakeUnique<CompiledProgram>();
+		compiled->instructions.reserve(program.size());
+
+		int stack_size = 0;
+		int max_stack_size = 0;
+
+		for (const InstructionData& instruction_data : program)
+		{
+			int data = 0;
+
+			switch (instruction_data.instruction)
+			{
+			case Instruction::Push:
+				stack_size += 1;
+				max_stack_size = Math::Max(max_stack_size, stack_size);
+				break;
+			case Instruction::Pop:
+				stack_size -= 1;
+				data = instruction_data.data.Get<int>(-1);
+				break;
+			case Instruction::Literal:
+				data = int(compiled->literals.size());
+				compiled->literals.push_back(TypedValue::FromVariant(instruction_data.data));
+				break;
+			case Instruction::Variable:
+				data = instruction_data.data.Get<int>(-1);
+				break;
+			case Instruction::Arguments:
+				data = instruction_data.data.Get<int>(-1);
+				stack_size -= data;
+				break;
+			case Instruction::TransformFnc:
+				data = int(compiled->function_names.size());
+				compiled->function_names.push_back(instruction_data.data.Get<String>());
+				break;
+			case Instruction::EventFnc:
+			case Instruction::Assign:
+				// Leave programs which modify the data model to the interpreter.
+				return nullptr;
+			default:
+				break;
+			}
+
+			compiled->instructions.push_back(CompiledInstruction{ instruction_data.instruction, data });
+		}
+
+		compiled->stack.resize(size_t(max_stack_size));
+
+		compiled->variables.reserve(addresses.size());
+		for (const DataAddress& address : addresses)
+			compiled->variables.push_back(expression_interface.GetStableVariable(address));
+
+		return compiled;
+	}
+
+} // </namespace Compile>
+
+
+class DataCompiledInterpreter {
+public:
+	DataCompiledInterpreter(CompiledProgram& program, const AddressList& addresses, DataExpressionInterface expression_interface)
+		: program(program), addresses(addresses), expression_interface(expression_interface) {}
+
+	bool Error(String message) const
+	{
+		message = "Error during execution. " + message;
+		Log::Message(Log::LT_WARNING, message.c_str());
+		RMLUI_ERROR;
+		return false;
+	}
+
+	bool Run()
+	{
+		for (const CompiledInstruction& instruction : program.instructions)
+		{
+			if (!Execute(instruction))
+			{
+				Log::Message(Log::LT_WARNING, "Failed to execute compiled program with %d instructions.", (int)program.instructions.size());
+				return false;
+			}
+		}
+
+		if (stack_size != 0)
+			Log::Message(Log::LT_WARNING, "Possible data interpreter stack corruption. Stack size is %d at end of execution (should be zero).", stack_size);
+
+		return true;
+	}
+
+	Variant Result() const {
+		return R.ToVariant();
+	}
+
+private:
+	TypedValue R, L, C;
+	int stack_size = 0;
+
+	CompiledProgram& program;
+	const AddressList& addresses;
+	DataExpressionInterface expression_interface;
+
+	bool Execute(const CompiledInstruction& instruction)
+	{
+		switch (instruction.instruction)
+		{
+		case Instruction::Push:
+		{
+			if (stack_size >= (int)program.stack.size())
+				return Error("Stack overflow.");
+			program.stack[stack_size++] = std::move(R);
+		}
+		break;
+		case Instruction::Pop:
+		{
+			if (stack_size <= 0)
+				return Error("Cannot pop stack, it is empty.");
+
+			TypedValue& top = program.stack[--stack_size];
+			switch (Register(instruction.data)) {
+			case Register::R:  R = std::move(top); break;
+			case Register::L:  L = std::move(top); break;
+			case Register::C:  C = std::move(top); break;
+			default:
+				return Error(CreateString(50, "Invalid register %d.", instruction.data));
+			}
+		}
+		break;
+		case Instruction::Literal:
+		{
+			R.Assign(program.literals[instruction.data]);
+		}
+		break;
+		case Instruction::Variable:
+		{
+			const size_t variable_index = size_t(instruction.data);
+			if (variable_index >= addresses.size())
+				return Error("Variable address not found.");
+
+			R.type = TypedValue::Type::Variant;
+			DataVariable& variable = program.variables[variable_index];
+			if (!variable || !variable.Get(R.variant))
+				R.variant = expression_interface.GetValue(addresses[variable_index]);
+		}
+		break;
+		case Instruction::Add:
+		{
+			if (L.IsString() || R.IsString())
+				R.SetVariant(Variant(L.GetString() + R.GetString()));
+			else
+				R.SetNumber(L.GetNumber() + R.GetNumber());
+		}
+		break;
+		case Instruction::Subtract:  R.SetNumber(L.GetNumber() - R.GetNumber());  break;
+		case Instruction::Multiply:  R.SetNumber(L.GetNumber() * R.GetNumber());  break;
+		case Instruction::Divide:    R.SetNumber(L.GetNumber() / R.GetNumber());  break;
+		case Instruction::Not:       R.SetBool(!R.GetBool());                     break;
+		case Instruction::And:       R.SetBool(L.GetBool() && R.GetBool());       break;
+		case Instruction::Or:        R.SetBool(L.GetBool() || R.GetBool());       break;
+		case Instruction::Less:      R.SetBool(L.GetNumber() < R.GetNumber());    break;
+		case Instruction::LessEq:    R.SetBool(L.GetNumber() <= R.GetNumber());   break;
+		case Instruction::Greater:   R.SetBool(L.GetNumber() > R.GetNumber());    break;
+		case Instruction::GreaterEq: R.SetBool(L.GetNumber() >= R.GetNumber());   break;
+		case Instruction::Equal:
+		{
+			if (L.IsString() || R.IsString())
+				R.SetBool(L.GetString() == R.GetString());
+			else
+				R.SetBool(L.GetNumber() == R.GetNumber());
+		}
+		break;
+		case Instruction::NotEqual:
+		{
+			if (L.IsString() || R.IsString())
+				R.SetBool(L.GetString() != R.GetString());
+			else
+				R.SetBool(L.GetNumber() != R.GetNumber());
+		}
+		break;
+		case Instruction::Ternary:
+		{
+			if (L.GetBool())
+				R = std::move(C);
+		}
+		break;
+		case Instruction::Arguments:
+		{
+			VariantList& arguments = program.arguments;
+			if (!arguments.empty())
+				return Error("Argument stack is not empty.");
+
+			const int num_arguments = instruction.data;
+			if (num_arguments < 0)
+				return Error("Invalid number of arguments.");
+			if (stack_size < num_arguments)
+				return Error(CreateString(100, "Cannot pop %d arguments, stack contains only %d elements.", num_arguments, stack_size));
+
+			arguments.resize(num_arguments);
+			for (int i = num_arguments - 1; i >= 0; i--)
+				arguments[i] = program.stack[--stack_size].ToVariant();
+		}
+		break;
+		case Instruction::TransformFnc:
+		{
+			const String& function_name = program.function_names[instruction.data];
+			VariantList& arguments = program.arguments;
+
+			Variant value = R.ToVariant();
+			if (!expression_interface.CallTransform(function_name, value, arguments))
+			{
+				String arguments_str;
+				for (size_t i = 0; i < arguments.size(); i++)
+				{
+					arguments_str += arguments[i].Get<String>();
+					if (i < arguments.size() - 1)
+						arguments_str += ", ";
+				}
+				Error(CreateString(50 + function_name.size() + arguments_str.size(), "Failed to execute data function: %s(%s)", function_name.c_str(), arguments_str.c_str()));
+			}
+			R = TypedValue::FromVariant(value);
+
+			arguments.clear();
+		}
+		break;
+		default:
+			RMLUI_ERRORMSG("Instruction not implemented."); break;
+		}
+		return true;
+	}
+};
+
+
 DataExpression::DataExpression(String expression) : expression(expression)
 {}
 
@@ -986,12 +1401,25 @@ bool DataExpression::Parse(const DataExpressionInterface& expression_interface,
 
 	program = parser.ReleaseProgram();
 	addresses = parser.ReleaseAddresses();
+	if (expression_interface.CompileExpressions())
+		compiled_program = Compile::Build(program, addresses, expression_interface);
 
 	return true;
 }
 
 bool DataExpression::Run(const DataExpressionInterface& expression_interface, Variant& out_value)
 {
+	if (compiled_program)
+	{
+		DataCompiledInterpreter interpreter(*compiled_program, addresses, expression_interface);
+
+		if (!interpreter.Run())
+			return false;
+
+		out_value = interpreter.Result();
+		return true;
+	}
+
 	DataInterpreter interpreter(program, addresses, expression_interface);
 	
 	if (!interpreter.Run())
@@ -1040,6 +1468,26 @@ Variant DataExpressionInterface::GetValue(const DataAddress& address) const
 	return result;
 }
 
+// Returns the variable at the given address if it stays at the same location for the lifetime of the data model, that is,
+// variables bound directly to the model and their struct members. Otherwise, such as for array elements which move when
+// the array is resized, an empty variable is returned and the address must be looked up whenever the value is needed.
+DataVariable DataExpressionInterface::GetStableVariable(const DataAddress& address) const
+{
+	if (!data_model || address.empty() || address.front().name == "ev" || address.front().name == "literal")
+		return DataVariable();
+
+	DataVariable variable = data_model->GetVariable(DataAddress{ address.front() });
+
+	for (size_t i = 1; i < address.size() && variable; i++)
+	{
+		if (variable.Type() != DataVariableType::Struct || address[i].index >= 0)
+			return DataVariable();
+		variable = variable.Child(address[i]);
+	}
+
+	return variable;
+}
+
 bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant& value) const
 {
 	bool result = false;
@@ -1059,6 +1507,11 @@ bool DataExpressionInterface::CallTransform(const String& name, Variant& inout_v
 	return data_model ? data_model->CallTransform(name, inout_variant, arguments) : false;
 }
 
+bool DataExpressionInterface::CompileExpressions() const
+{
+	return data_model ? data_model->GetCompileExpressions() : true;
+}
+
 bool DataExpressionInterface::EventCallback(const String& name, const VariantList& arguments)
 {
 	if (!data_model || !event)
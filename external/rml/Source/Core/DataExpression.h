@@ -38,6 +38,7 @@ namespace Rml {
 class Element;
 class DataModel;
 struct InstructionData;
+struct CompiledProgram;
 using Program = Vector<InstructionData>;
 using AddressList = Vector<DataAddress>;
 
@@ -48,9 +49,11 @@ public:
 
     DataAddress ParseAddress(const String& address_str) const;
     Variant GetValue(const DataAddress& address) const;
+    DataVariable GetStableVariable(const DataAddress& address) const;
     bool SetValue(const DataAddress& address, const Variant& value) const;
     bool CallTransform(const String& name, Variant& inout_result, const VariantList& arguments);
     bool EventCallback(const String& name, const VariantList& arguments);
+    bool CompileExpressions() const;
 
 private:
     DataModel* data_model = nullptr;
@@ -76,6 +79,9 @@ private:
     
     Program program;
     AddressList addresses;
+
+    // Compiled form of the program, used to run expressions which do not modify the data model.
+    UniquePtr<CompiledProgram> compiled_program;
 };
 
 } // namespace Rml
@@ -347,6 +347,16 @@ bool DataModel::CallTransform(const String& name, Variant& inout_result, const V
 	return false;
 }
 
+void DataModel::SetCompileExpressions(bool compile)
+{
+	compile_expressions = compile;
+}
+
+bool DataModel::GetCompileExpressions() const
+{
+	return compile_expressions;
+}
+
 void DataModel::AttachModelRootElement(Element* element)
 {
 	attached_elements.insert(element);
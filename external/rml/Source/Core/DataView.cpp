@@ -77,6 +77,9 @@ void DataViews::OnElementRemove(Element* element)
 		auto& view = *it;
 		if (view && view->GetElement() == element)
 		{
+			// The element may be attached again later, such as rows recycled by the 'data-for' view. Detach the view so
+			// that it is no longer updated, even if it was already scheduled for the current update.
+			view->attached_element.reset();
 			views_to_remove.push_back(std::move(view));
 			it = views.erase(it);
 		}
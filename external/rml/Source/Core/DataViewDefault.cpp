@@ -29,10 +29,13 @@
 #include "DataViewDefault.h"
 #include "DataExpression.h"
 #include "../../Include/RmlUi/Core/DataModel.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Variant.h"
+#include "../../Include/RmlUi/Core/XMLParser.h"
 
 namespace Rml {
 
@@ -264,17 +267,23 @@ bool DataViewVisible::Update(DataModel& model)
 DataViewText::DataViewText(Element* element) : DataView(element)
 {}
 
-bool DataViewText::Initialize(DataModel& model, Element* element, const String& RMLUI_UNUSED_PARAMETER(expression), const String& RMLUI_UNUSED_PARAMETER(modifier))
+bool DataViewText::Initialize(DataModel& model, Element* element, const String& expression, const String& RMLUI_UNUSED_PARAMETER(modifier))
 {
-	RMLUI_UNUSED(expression);
 	RMLUI_UNUSED(modifier);
 
 	ElementText* element_text = rmlui_dynamic_cast<ElementText*>(element);
 	if (!element_text)
 		return false;
 
-	const String& in_text = element_text->GetText();
-	
+	// The source text is stored in the attribute, so that the view can be constructed again after the text has been
+	// substituted, such as when the element is detached and then recycled by a 'data-for' view.
+	String in_text = expression;
+	if (in_text.empty())
+	{
+		in_text = element_text->GetText();
+		element->SetAttribute("data-text", in_text);
+	}
+
 	text.reserve(in_text.size());
 
 	DataExpressionInterface expression_interface(&model, element);
@@ -403,9 +412,72 @@ String DataViewText::BuildText() const
 
 
 
+// Number of released rows kept for recycling, so that shrinking a large list does not hold on to all of its elements.
+static constexpr size_t max_pooled_rows = 128;
+
+// Number of rows instanced beyond each edge of the viewport of virtualized lists.
+static constexpr int virtual_row_overscan = 2;
+
+// Returns true if the element's descendants can be copied element by element, instead of being parsed from rml.
+// Elements with their own xml node handlers or structural data views need the parser to construct them.
+static bool IsTemplateCopyable(const Element* element)
+{
+	const StringList& structural_attribute_names = Factory::GetStructuralDataViewAttributeNames();
+
+	for (int i = 0; i < element->GetNumChildren(); i++)
+	{
+		const Element* child = element->GetChild(i);
+
+		if (XMLParser::GetNodeHandler(child->GetTagName()))
+			return false;
+
+		for (const String& name : structural_attribute_names)
+		{
+			if (child->GetAttributes().count(name))
+				return false;
+		}
+
+		if (!IsTemplateCopyable(child))
+			return false;
+	}
+
+	return true;
+}
+
+// Copies the descendants of the template element to the target element.
+static void CopyTemplateChildren(const Element* template_element, Element* target)
+{
+	for (int i = 0; i < template_element->GetNumChildren(); i++)
+	{
+		const Element* child = template_element->GetChild(i);
+		const String& tag = child->GetTagName();
+
+		ElementPtr copy = Factory::InstanceElement(nullptr, tag, tag, child->GetAttributes());
+		if (!copy)
+			continue;
+
+		if (const ElementText* child_text = rmlui_dynamic_cast<const ElementText*>(child))
+		{
+			if (ElementText* copy_text = rmlui_dynamic_cast<ElementText*>(copy.get()))
+				copy_text->SetText(child_text->GetText());
+		}
+
+		CopyTemplateChildren(child, copy.get());
+		target->AppendChild(std::move(copy));
+	}
+}
+
 DataViewFor::DataViewFor(Element* element) : DataView(element)
 {}
 
+DataViewFor::~DataViewFor()
+{
+	if (Element* viewport_element = viewport.get())
+		viewport_element->RemoveEventListener(EventId::Scroll, this);
+	if (Element* document_element = document.get())
+		document_element->RemoveEventListener(EventId::Resize, this);
+}
+
 bool DataViewFor::Initialize(DataModel& model, Element* element, const String& in_expression, const String& in_rml_content)
 {
 	rml_contents = in_rml_content;
@@ -454,6 +526,32 @@ bool DataViewFor::Initialize(DataModel& model, Element* element, const String& i
 
 	element->SetProperty(PropertyId::Display, Property(Style::Display::None));
 
+	// Parse the row contents once, new rows are then copied from the template.
+	row_template = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+	if (row_template)
+	{
+		row_template->SetInnerRML(rml_contents);
+		if (!IsTemplateCopyable(row_template.get()))
+			row_template.reset();
+	}
+
+	row_height = element->GetAttribute("virtual-row-height", 0.f);
+	if (row_height > 0.f)
+	{
+		Element* parent = element->GetParentNode();
+		leading_spacer = parent->InsertBefore(CreateSpacer(), element);
+		trailing_spacer = parent->InsertBefore(CreateSpacer(), element);
+
+		viewport = parent->GetObserverPtr();
+		parent->AddEventListener(EventId::Scroll, this);
+
+		if (ElementDocument* owner_document = element->GetOwnerDocument())
+		{
+			document = owner_document->GetObserverPtr();
+			owner_document->AddEventListener(EventId::Resize, this);
+		}
+	}
+
 	return true;
 }
 
@@ -464,48 +562,158 @@ bool DataViewFor::Update(DataModel& model)
 	if (!variable)
 		return false;
 
-	bool result = false;
-	const int size = variable.Size();
-	const int num_elements = (int)elements.size();
-	Element* element = GetElement();
+	num_items = variable.Size();
+
+	int begin = 0, end = 0;
+	GetRowRange(num_items, begin, end);
 
-	for (int i = 0; i < Math::Max(size, num_elements); i++)
+	if (leading_spacer && trailing_spacer)
 	{
-		if (i >= num_elements)
-		{
-			ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+		leading_spacer->SetProperty(PropertyId::Height, Property(float(begin) * row_height, Property::PX));
+		trailing_spacer->SetProperty(PropertyId::Height, Property(float(num_items - end) * row_height, Property::PX));
+	}
 
-			DataAddress iterator_address;
-			iterator_address.reserve(container_address.size() + 1);
-			iterator_address = container_address;
-			iterator_address.push_back(DataAddressEntry(i));
+	const int previous_begin = first_index;
+	const int previous_end = first_index + (int)elements.size();
+	if (begin == previous_begin && end == previous_end)
+		return false;
 
-			DataAddress iterator_index_address = {
-				{"literal"}, {"int"}, {i}
-			};
+	// Release the rows which are no longer in range before instancing new ones, so that they can be recycled.
+	ElementList kept_elements;
+	for (int i = previous_begin; i < previous_end; i++)
+	{
+		Element* row = elements[i - previous_begin];
+		if (i < begin || i >= end)
+			ReleaseRow(model, row);
+		else
+			kept_elements.push_back(row);
+	}
 
-			model.InsertAlias(new_element_ptr.get(), iterator_name, std::move(iterator_address));
-			model.InsertAlias(new_element_ptr.get(), iterator_index_name, std::move(iterator_index_address));
+	const int kept_begin = (kept_elements.empty() ? end : Math::Max(begin, previous_begin));
+	const int kept_end = kept_begin + (int)kept_elements.size();
 
-			Element* new_element = element->GetParentNode()->InsertBefore(std::move(new_element_ptr), element);
-			elements.push_back(new_element);
+	Element* element = GetElement();
+	Element* list_end = (trailing_spacer ? trailing_spacer : element);
 
-			elements[i]->SetInnerRML(rml_contents);
+	ElementList new_elements;
+	new_elements.reserve(end - begin);
 
-			RMLUI_ASSERT(i < (int)elements.size());
-		}
-		if (i >= size)
-		{
-			model.EraseAliases(elements[i]);
-			elements[i]->GetParentNode()->RemoveChild(elements[i]).reset();
-			elements[i] = nullptr;
-		}
+	Element* next_sibling = (kept_elements.empty() ? list_end : kept_elements.front());
+	for (int i = begin; i < kept_begin; i++)
+		new_elements.push_back(InsertRow(model, i, next_sibling));
+
+	new_elements.insert(new_elements.end(), kept_elements.begin(), kept_elements.end());
+
+	for (int i = kept_end; i < end; i++)
+		new_elements.push_back(InsertRow(model, i, list_end));
+
+	elements = std::move(new_elements);
+	first_index = begin;
+
+	return true;
+}
+
+void DataViewFor::GetRowRange(int in_num_items, int& out_begin, int& out_end)
+{
+	out_begin = 0;
+	out_end = in_num_items;
+
+	Element* viewport_element = viewport.get();
+	if (row_height <= 0.f || !viewport_element || !leading_spacer)
+		return;
+
+	// Before the first layout the viewport has no height, it can't be taller than the context though.
+	float viewport_height = viewport_element->GetClientHeight();
+	if (Context* context = viewport_element->GetContext())
+	{
+		const float context_height = (float)context->GetDimensions().y;
+		if (viewport_height <= 0.f || viewport_height > context_height)
+			viewport_height = context_height;
 	}
 
-	if (num_elements > size)
-		elements.resize(size);
+	// Both offsets include the viewport's scrolling, so this is the visible top relative to the start of the list.
+	const float visible_top = viewport_element->GetAbsoluteOffset(Box::PADDING).y - leading_spacer->GetAbsoluteOffset(Box::BORDER).y;
+	const int num_visible_rows = Math::RoundUpToInteger(viewport_height / row_height);
 
-	return result;
+	// The scroll offset may be outdated when the list shrinks, it will be clamped to the end of the list during layout.
+	const int first_visible_row = Math::Min(Math::RoundDownToInteger(visible_top / row_height), in_num_items - num_visible_rows);
+
+	out_begin = Math::Clamp(first_visible_row - virtual_row_overscan, 0, in_num_items);
+	out_end = Math::Clamp(first_visible_row + num_visible_rows + 1 + virtual_row_overscan, out_begin, in_num_items);
+}
+
+Element* DataViewFor::InsertRow(DataModel& model, int index, Element* next_sibling)
+{
+	Element* element = GetElement();
+
+	ElementPtr row_ptr;
+	if (!row_pool.empty())
+	{
+		row_ptr = std::move(row_pool.back());
+		row_pool.pop_back();
+	}
+	else
+	{
+		row_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+		if (row_template)
+			CopyTemplateChildren(row_template.get(), row_ptr.get());
+	}
+
+	DataAddress iterator_address;
+	iterator_address.reserve(container_address.size() + 1);
+	iterator_address = container_address;
+	iterator_address.push_back(DataAddressEntry(index));
+
+	DataAddress iterator_index_address = {
+		{"literal"}, {"int"}, {index}
+	};
+
+	model.InsertAlias(row_ptr.get(), iterator_name, std::move(iterator_address));
+	model.InsertAlias(row_ptr.get(), iterator_index_name, std::move(iterator_index_address));
+
+	// Data views and controllers of the row contents are constructed as the row is attached to the data model.
+	Element* row = element->GetParentNode()->InsertBefore(std::move(row_ptr), next_sibling);
+
+	if (!row_template)
+		row->SetInnerRML(rml_contents);
+
+	return row;
+}
+
+void DataViewFor::ReleaseRow(DataModel& model, Element* row)
+{
+	model.EraseAliases(row);
+	ElementPtr row_ptr = row->GetParentNode()->RemoveChild(row);
+
+	// Detaching the row removed its data views and controllers, thus it can be bound to another index later.
+	if (row_template && row_pool.size() < max_pooled_rows)
+		row_pool.push_back(std::move(row_ptr));
+}
+
+ElementPtr DataViewFor::CreateSpacer()
+{
+	XMLAttributes spacer_attributes;
+	spacer_attributes.emplace("style", Variant("margin-top: 0; margin-bottom: 0; padding-top: 0; padding-bottom: 0; border-top-width: 0; border-bottom-width: 0; height: 0;"));
+
+	const String& tag = GetElement()->GetTagName();
+	return Factory::InstanceElement(nullptr, tag, tag, spacer_attributes);
+}
+
+void DataViewFor::ProcessEvent(Event& /*event*/)
+{
+	if (!IsValid())
+		return;
+
+	DataModel* model = GetElement()->GetDataModel();
+	if (!model)
+		return;
+
+	int begin = 0, end = 0;
+	GetRowRange(num_items, begin, end);
+
+	// Rows are instanced during the next data model update.
+	if (begin != first_index || end != first_index + (int)elements.size())
+		model->DirtyVariable(container_address.front().name);
 }
 
 StringList DataViewFor::GetVariableNameList() const {
@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/DataView.h"
+#include "../../Include/RmlUi/Core/EventListener.h"
 #include "../../Include/RmlUi/Core/Variant.h"
 
 namespace Rml {
@@ -151,9 +152,20 @@ private:
 };
 
 
-class DataViewFor final : public DataView {
+/**
+	Structural data view which constructs one row element per item of the bound container.
+
+	Row bodies are parsed once into a template and copied for each new row, and removed rows are kept in a pool
+	and rebound to new indices. Rows containing elements which need the xml parser, such as nested structural
+	views, are parsed from the inner rml every time instead. If the element has a 'virtual-row-height' attribute, the list is virtualized:
+	only the rows intersecting the parent element's scroll viewport are instanced, while spacer elements take
+	the place of the remaining rows. Virtualized rows must all be the given height in pixels, including margins.
+ */
+
+class DataViewFor final : public DataView, private EventListener {
 public:
 	DataViewFor(Element* element);
+	~DataViewFor();
 
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& inner_rml) override;
 
@@ -162,16 +174,41 @@ public:
 	StringList GetVariableNameList() const override;
 
 protected:
+	// Responds to 'scroll' and 'resize' events of virtualized lists.
+	void ProcessEvent(Event& event) override;
+
 	void Release() override;
 
 private:
+	// Returns the range of item indices which should be instanced as rows.
+	void GetRowRange(int num_items, int& out_begin, int& out_end);
+
+	Element* InsertRow(DataModel& model, int index, Element* next_sibling);
+	void ReleaseRow(DataModel& model, Element* row);
+
+	ElementPtr CreateSpacer();
+
 	DataAddress container_address;
 	String iterator_name;
 	String iterator_index_name;
 	String rml_contents;
 	ElementAttributes attributes;
 
+	// Row contents parsed from 'rml_contents', or null if they can not be copied and must be parsed for every row.
+	ElementPtr row_template;
+	Vector<ElementPtr> row_pool;
+
+	// The rows currently instanced, for the item indices starting at 'first_index'.
 	ElementList elements;
+	int first_index = 0;
+	int num_items = 0;
+
+	// Virtualization, enabled when the row height is positive.
+	float row_height = 0.f;
+	ObserverPtr<Element> viewport;
+	ObserverPtr<Element> document;
+	Element* leading_spacer = nullptr;
+	Element* trailing_spacer = nullptr;
 };
 
 } // namespace Rml
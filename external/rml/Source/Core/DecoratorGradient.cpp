@@ -89,7 +89,7 @@ DecoratorDataHandle DecoratorGradient::GenerateElementData(Element* element) con
 	const Vector2f padding_offset = box.GetPosition(Box::PADDING);
 	const Vector2f padding_size = box.GetSize(Box::PADDING);
 
-	Vector<Vertex>& vertices = geometry->GetVertices();
+	MemoryVector<Vertex>& vertices = geometry->GetVertices();
 
 	if (dir == Direction::Horizontal)
 	{
@@ -127,8 +127,8 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element) co
 
 	/* Now we have all the coordinates we need. Expand the diagonal vertices to the 16 individual vertices. */
 
-	Vector<Vertex>& vertices = data->GetVertices();
-	Vector<int>& indices = data->GetIndices();
+	MemoryVector<Vertex>& vertices = data->GetVertices();
+	MemoryVector<int>& indices = data->GetIndices();
 
 	vertices.resize(4 * 4);
 
@@ -68,27 +68,22 @@ void DecoratorTiled::Tile::CalculateDimensions(Element* element, const Texture&
 		const Vector2i texture_dimensions_i = texture.GetDimensions(render_interface);
 		const Vector2f texture_dimensions((float)texture_dimensions_i.x, (float)texture_dimensions_i.y);
 
+		// The texture may still be loading, don't store anything so that we try again when the decorator is regenerated.
 		if (texture_dimensions.x == 0 || texture_dimensions.y == 0)
-		{
-			new_data.size = Vector2f(0, 0);
-			new_data.texcoords[0] = Vector2f(0, 0);
-			new_data.texcoords[1] = Vector2f(0, 0);
-		}
+			return;
+
+		// Need to scale the coordinates to normalized units and 'size' to absolute size (pixels)
+		if (size.x == 0 && size.y == 0 && position.x == 0 && position.y == 0)
+			new_data.size = texture_dimensions;
 		else
-		{
-			// Need to scale the coordinates to normalized units and 'size' to absolute size (pixels)
-			if (size.x == 0 && size.y == 0 && position.x == 0 && position.y == 0)
-				new_data.size = texture_dimensions;
-			else
-				new_data.size = size;
-			
-			Vector2f size_relative = new_data.size / texture_dimensions;
-
-			new_data.size = Vector2f(Math::AbsoluteValue(new_data.size.x), Math::AbsoluteValue(new_data.size.y));
-
-			new_data.texcoords[0] = position / texture_dimensions;
-			new_data.texcoords[1] = size_relative + new_data.texcoords[0];
-		}
+			new_data.size = size;
+		
+		Vector2f size_relative = new_data.size / texture_dimensions;
+
+		new_data.size = Vector2f(Math::AbsoluteValue(new_data.size.x), Math::AbsoluteValue(new_data.size.y));
+
+		new_data.texcoords[0] = position / texture_dimensions;
+		new_data.texcoords[1] = size_relative + new_data.texcoords[0];
 
 		data.emplace( render_interface, new_data );
 	}
@@ -106,7 +101,7 @@ Vector2f DecoratorTiled::Tile::GetDimensions(Element* element) const
 }
 
 // Generates geometry to render this tile across a surface.
-void DecoratorTiled::Tile::GenerateGeometry(Vector< Vertex >& vertices, Vector< int >& indices, Element* element, const Vector2f& surface_origin, const Vector2f& surface_dimensions, const Vector2f& tile_dimensions) const
+void DecoratorTiled::Tile::GenerateGeometry(MemoryVector< Vertex >& vertices, MemoryVector< int >& indices, Element* element, const Vector2f& surface_origin, const Vector2f& surface_dimensions, const Vector2f& tile_dimensions) const
 {
 	if (surface_dimensions.x <= 0 || surface_dimensions.y <= 0)
 		return;
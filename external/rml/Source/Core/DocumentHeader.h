@@ -33,6 +33,7 @@
 
 namespace Rml {
 
+class StyleSheet;
 using LineNumberList = Vector<int>;
 
 /**
@@ -63,6 +64,9 @@ public:
 	/// External scripts that should be loaded
 	StringList scripts_external;
 
+	/// The combined style sheet of an earlier load of the same document, used instead of loading the RCSS if set
+	SharedPtr<StyleSheet> style_sheet;
+
 	/// Merges the specified header with this one
 	/// @param header Header to merge
 	void MergeHeader(const DocumentHeader& header);
@@ -34,6 +34,7 @@
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementScroll.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Dictionary.h"
@@ -44,8 +45,10 @@
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
 #include "Clock.h"
+#include "Compositor.h"
 #include "ComputeProperty.h"
 #include "ElementAnimation.h"
+#include "ElementArena.h"
 #include "ElementBackgroundBorder.h"
 #include "ElementDefinition.h"
 #include "ElementStyle.h"
@@ -63,6 +66,7 @@
 #include "XMLParseTools.h"
 #include <algorithm>
 #include <cmath>
+#include <mutex>
 
 namespace Rml {
 
@@ -83,11 +87,14 @@ struct ElementMeta
 
 
 static Pool< ElementMeta > element_meta_chunk_pool(200, true);
+// Only guards the pool, meta data is constructed and destroyed outside of the lock since that creates and releases the
+// scrollbar elements.
+static std::mutex element_meta_chunk_pool_mutex;
 
 
 /// Constructs a new RmlUi element.
 Element::Element(const String& tag) : tag(tag), relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0), content_offset(0, 0), content_box(0, 0), 
-transform_state(), dirty_transform(false), dirty_perspective(false), dirty_animation(false), dirty_transition(false)
+transform_state(), dirty_transform(false), dirty_perspective(false), dirty_animation(false), dirty_transition(false), composited_animations(false)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
 	parent = nullptr;
@@ -115,9 +122,26 @@ transform_state(), dirty_transform(false), dirty_perspective(false), dirty_anima
 
 	structure_dirty = false;
 
+	clip_ignoring_descendant = false;
+	clip_ignoring_descendant_dirty = true;
+
 	computed_values_are_default_initialized = true;
 
-	meta = element_meta_chunk_pool.AllocateAndConstruct(this);
+	// Elements instanced into a document share its arena with their meta data.
+	arena = ElementArena::ReleaseConstructionArena();
+	if (arena)
+	{
+		meta = new (arena->Allocate(sizeof(ElementMeta))) ElementMeta(this);
+	}
+	else
+	{
+		void* memory;
+		{
+			std::lock_guard<std::mutex> lock(element_meta_chunk_pool_mutex);
+			memory = element_meta_chunk_pool.Allocate();
+		}
+		meta = new (memory) ElementMeta(this);
+	}
 	data_model = nullptr;
 }
 
@@ -140,7 +164,18 @@ Element::~Element()
 	children.clear();
 	num_non_dom_children = 0;
 
-	element_meta_chunk_pool.DestroyAndDeallocate(meta);
+	if (arena)
+	{
+		meta->~ElementMeta();
+		arena->Deallocate(meta, sizeof(ElementMeta));
+	}
+	else
+	{
+		meta->~ElementMeta();
+
+		std::lock_guard<std::mutex> lock(element_meta_chunk_pool_mutex);
+		element_meta_chunk_pool.Deallocate(meta);
+	}
 }
 
 void Element::Update(float dp_ratio)
@@ -203,7 +238,10 @@ void Element::UpdateProperties()
 		// Computed values are just calculated and can safely be used in OnPropertyChange.
 		// However, new properties set during this call will not be available until the next update loop.
 		if (!dirty_properties.Empty())
+		{
+			DirtyRender();
 			OnPropertyChange(dirty_properties);
+		}
 	}
 }
 
@@ -234,16 +272,30 @@ void Element::Render()
 	// Apply our transform
 	ElementUtilities::ApplyTransform(*this);
 
+	// Apply the animated opacity, if any, which is not baked into our geometry.
+	if (Context* context = GetContext())
+		context->compositor->ApplyOpacity(*this, context->GetRenderInterface());
+
 	// Set up the clipping region for this element.
 	if (ElementUtilities::SetClippingRegion(this))
 	{
-		meta->background_border.Render(this);
-		meta->decoration.RenderDecorators();
-
+		if (!IsOutsideActiveClipRegion())
 		{
-			RMLUI_ZoneScopedNC("OnRender", 0x228B22);
+			meta->background_border.Render(this);
+			meta->decoration.RenderDecorators();
 
-			OnRender();
+			{
+				RMLUI_ZoneScopedNC("OnRender", 0x228B22);
+
+				OnRender();
+			}
+		}
+		else if (IsClippingEnabled())
+		{
+			// Our content is clipped to our own box which is not visible, so the rest of our stacking context can be
+			// skipped as well, unless any of our descendants ignores our clipping region.
+			if (!HasClipIgnoringDescendant())
+				return;
 		}
 	}
 
@@ -465,6 +517,7 @@ void Element::SetBox(const Box& box)
 		additional_boxes.clear();
 
 		OnResize();
+		DirtyHitTest();
 
 		meta->background_border.DirtyBackground();
 		meta->background_border.DirtyBorder();
@@ -478,6 +531,7 @@ void Element::AddBox(const Box& box, Vector2f offset)
 	additional_boxes.emplace_back(PositionedBox{ box, offset });
 
 	OnResize();
+	DirtyHitTest();
 
 	meta->background_border.DirtyBackground();
 	meta->background_border.DirtyBorder();
@@ -551,6 +605,40 @@ bool Element::IsPointWithinElement(const Vector2f& point)
 	return false;
 }
 
+// Checks if the element's border boxes lie completely outside the context's active clipping region.
+bool Element::IsOutsideActiveClipRegion()
+{
+	Vector2i clip_origin, clip_dimensions;
+	if (!GetContext()->GetActiveClipRegion(clip_origin, clip_dimensions))
+		return false;
+
+	// Our boxes are in untransformed space while the clipping region is not, text elements cull their own lines.
+	if ((transform_state && transform_state->GetTransform()) || rmlui_dynamic_cast<ElementText*>(this))
+		return false;
+
+	const Vector2f clip_top_left((float)clip_origin.x, (float)clip_origin.y);
+	const Vector2f clip_bottom_right = clip_top_left + Vector2f((float)clip_dimensions.x, (float)clip_dimensions.y);
+	const Vector2f position = GetAbsoluteOffset(Box::BORDER);
+
+	for (int i = 0; i < GetNumBoxes(); ++i)
+	{
+		Vector2f box_offset;
+		const Box& box = GetBox(i, box_offset);
+
+		const Vector2f box_top_left = position + box_offset;
+		const Vector2f box_bottom_right = box_top_left + box.GetSize(Box::BORDER);
+		if (box_top_left.x < clip_bottom_right.x &&
+			box_bottom_right.x > clip_top_left.x &&
+			box_top_left.y < clip_bottom_right.y &&
+			box_bottom_right.y > clip_top_left.y)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // Returns the visibility of the element.
 bool Element::IsVisible() const
 {
@@ -608,12 +696,14 @@ void Element::RemoveProperty(PropertyId id)
 // Returns one of this element's properties.
 const Property* Element::GetProperty(const String& name)
 {
-	return meta->style.GetProperty(StyleSheetSpecification::GetPropertyId(name));
+	return GetProperty(StyleSheetSpecification::GetPropertyId(name));
 }
 
 // Returns one of this element's properties.
 const Property* Element::GetProperty(PropertyId id)
 {
+	if (const Property* property = GetCompositedProperty(id))
+		return property;
 	return meta->style.GetProperty(id);
 }
 
@@ -952,6 +1042,7 @@ void Element::SetScrollLeft(float scroll_left)
 		scroll_offset.x = new_offset;
 		meta->scroll.UpdateScrollbar(ElementScroll::HORIZONTAL);
 		DirtyOffset();
+		DirtyRender();
 
 		DispatchEvent(EventId::Scroll, Dictionary());
 	}
@@ -972,6 +1063,7 @@ void Element::SetScrollTop(float scroll_top)
 		scroll_offset.y = new_offset;
 		meta->scroll.UpdateScrollbar(ElementScroll::VERTICAL);
 		DirtyOffset();
+		DirtyRender();
 
 		DispatchEvent(EventId::Scroll, Dictionary());
 	}
@@ -1611,6 +1703,8 @@ void Element::OnLayout()
 // Called when attributes on the element are changed.
 void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 {
+	DirtyRender();
+
 	auto it = changed_attributes.find("id");
 	if (it != changed_attributes.end())
 	{
@@ -1692,6 +1786,9 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 			if (parent != nullptr)
 				parent->DirtyStackingContext();
 
+			// Our parent may be the root element, which is not part of any document.
+			DirtyHitTest();
+
 			if (!visible)
 				Blur();
 		}
@@ -1717,6 +1814,10 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		DirtyOffset();
 	}
 
+	// Our parent skips rendering its clipped subtrees based on whether any descendant ignores clipping.
+	if (changed_properties.Contains(PropertyId::Clip) && parent != nullptr)
+		parent->DirtyClipIgnoringDescendant();
+
 	// Update the z-index.
 	if (changed_properties.Contains(PropertyId::ZIndex))
 	{
@@ -1732,6 +1833,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 
 				stacking_context_dirty = false;
 				stacking_context.clear();
+				DirtyHitTest();
 			}
 
 			// If our old z-index was not zero, then we must dirty our stacking context so we'll be re-indexed.
@@ -1757,6 +1859,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 			{
 				local_stacking_context = true;
 				stacking_context_dirty = true;
+				DirtyHitTest();
 			}
 		}
 	}
@@ -1836,9 +1939,21 @@ void Element::OnChildRemove(Element* /*child*/)
 // Forces a re-layout of this element, and any other children required.
 void Element::DirtyLayout()
 {
-	Element* document = GetOwnerDocument();
-	if (document != nullptr)
-		document->DirtyLayout();
+	ElementDocument* document = GetOwnerDocument();
+	if (document == nullptr)
+		return;
+
+	// Changes inside a layout boundary can't affect the layout outside of it, so only the closest boundary needs to be formatted.
+	for (Element* ancestor = parent; ancestor && ancestor != document; ancestor = ancestor->parent)
+	{
+		if (LayoutEngine::IsLayoutBoundary(ancestor))
+		{
+			document->DirtyLayoutBoundary(ancestor);
+			return;
+		}
+	}
+
+	document->DirtyLayout();
 }
 
 // Forces a re-layout of this element, and any other children required.
@@ -1996,8 +2111,14 @@ void Element::SetParent(Element* _parent)
 	// Assumes we are already detached from the hierarchy or we are detaching now.
 	RMLUI_ASSERT(!parent || !_parent);
 
+	if (parent)
+		parent->DirtyClipIgnoringDescendant();
+
 	parent = _parent;
 
+	if (parent)
+		parent->DirtyClipIgnoringDescendant();
+
 	if (parent)
 	{
 		// We need to update our definition and make sure we inherit the properties of our new parent.
@@ -2047,6 +2168,7 @@ void Element::DirtyOffset()
 	if(!offset_dirty)
 	{
 		offset_dirty = true;
+		DirtyHitTest();
 
 		if(transform_state)
 			DirtyTransformState(true, true);
@@ -2262,6 +2384,47 @@ void Element::DirtyStackingContext()
 
 	if (stacking_context_parent)
 		stacking_context_parent->stacking_context_dirty = true;
+
+	DirtyRender();
+	DirtyHitTest();
+}
+
+bool Element::HasClipIgnoringDescendant()
+{
+	if (clip_ignoring_descendant_dirty)
+	{
+		// Visit every child so that no dirty descendant is left below a clean ancestor.
+		bool result = false;
+		for (const ElementPtr& child : children)
+		{
+			if (child->HasClipIgnoringDescendant() || child->GetClippingIgnoreDepth() != 0)
+				result = true;
+		}
+
+		clip_ignoring_descendant = result;
+		clip_ignoring_descendant_dirty = false;
+	}
+
+	return clip_ignoring_descendant;
+}
+
+void Element::DirtyClipIgnoringDescendant()
+{
+	// Ancestors of a dirty element are always dirty, so we can stop at the first one.
+	for (Element* element = this; element && !element->clip_ignoring_descendant_dirty; element = element->parent)
+		element->clip_ignoring_descendant_dirty = true;
+}
+
+void Element::DirtyRender()
+{
+	if (Context* context = GetContext())
+		context->SetRenderDirty();
+}
+
+void Element::DirtyHitTest()
+{
+	if (Context* context = GetContext())
+		context->DirtyHitTestGrid();
 }
 
 void Element::DirtyStructure()
@@ -2300,6 +2463,8 @@ bool Element::Animate(const String & property_name, const Property & target_valu
 
 bool Element::AddAnimationKey(const String & property_name, const Property & target_value, float duration, Tween tween)
 {
+	ReclaimCompositedAnimations();
+
 	ElementAnimation* animation = nullptr;
 
 	PropertyId property_id = StyleSheetSpecification::GetPropertyId(property_name);
@@ -2321,6 +2486,8 @@ bool Element::AddAnimationKey(const String & property_name, const Property & tar
 
 ElementAnimationList::iterator Element::StartAnimation(PropertyId property_id, const Property* start_value, int num_iterations, bool alternate_direction, float delay, bool initiated_by_animation_property)
 {
+	ReclaimCompositedAnimations();
+
 	auto it = std::find_if(animations.begin(), animations.end(), [&](const ElementAnimation& el) { return el.GetPropertyId() == property_id; });
 
 	if (it != animations.end())
@@ -2371,6 +2538,8 @@ bool Element::AddAnimationKeyTime(PropertyId property_id, const Property* target
 	if (!target_value)
 		return false;
 
+	ReclaimCompositedAnimations();
+
 	ElementAnimation* animation = nullptr;
 
 	for (auto& existing_animation : animations) {
@@ -2387,8 +2556,12 @@ bool Element::AddAnimationKeyTime(PropertyId property_id, const Property* target
 	return result;
 }
 
-bool Element::StartTransition(const Transition & transition, const Property& start_value, const Property & target_value)
+bool Element::StartTransition(const Transition & transition, const Property& in_start_value, const Property & target_value)
 {
+	// The start value may be owned by the compositor, which releases it when we take our animations back.
+	const Property start_value = in_start_value;
+	ReclaimCompositedAnimations();
+
 	auto it = std::find_if(animations.begin(), animations.end(), [&](const ElementAnimation& el) { return el.GetPropertyId() == transition.id; });
 
 	if (it != animations.end() && !it->IsTransition())
@@ -2437,6 +2610,8 @@ void Element::HandleTransitionProperty()
 		if (keep_transitions.all)
 			return;
 
+		ReclaimCompositedAnimations();
+
 		auto it_remove = animations.end();
 
 		if (keep_transitions.none)
@@ -2482,7 +2657,7 @@ void Element::HandleAnimationProperty()
 		dirty_animation = false;
 
 		const AnimationList& animation_list = meta->computed_values.animation;
-		bool element_has_animations = (!animation_list.empty() || !animations.empty());
+		bool element_has_animations = (!animation_list.empty() || !animations.empty() || composited_animations);
 		StyleSheet* stylesheet = nullptr;
 
 		if (element_has_animations)
@@ -2490,6 +2665,8 @@ void Element::HandleAnimationProperty()
 
 		if (stylesheet)
 		{
+			ReclaimCompositedAnimations();
+
 			// Remove existing animations
 			{
 				// We only touch the animations that originate from the 'animation' property.
@@ -2545,11 +2722,28 @@ void Element::AdvanceAnimations()
 	{
 		double time = Clock::GetElapsedTime();
 
-		for (auto& animation : animations)
+		// Animations which only change our transform or opacity are handed to our context's compositor, which animates
+		// them without restyling us or regenerating our geometry.
+		Context* context = GetContext();
+		RenderInterface* render_interface = (context ? context->GetRenderInterface() : nullptr);
+
+		for (auto it = animations.begin(); it != animations.end();)
 		{
-			Property property = animation.UpdateAndGetProperty(time, *this);
-			if (property.unit != Property::UNKNOWN)
-				SetProperty(animation.GetPropertyId(), property);
+			Property property = it->UpdateAndGetProperty(time, *this);
+			if (property.unit == Property::UNKNOWN)
+			{
+				++it;
+			}
+			else if (context && !it->IsComplete() && Compositor::CanComposite(it->GetPropertyId(), render_interface))
+			{
+				context->compositor->AddAnimation(this, std::move(*it), property);
+				it = animations.erase(it);
+			}
+			else
+			{
+				SetProperty(it->GetPropertyId(), property);
+				++it;
+			}
 		}
 
 		// Move all completed animations to the end of the list
@@ -2582,7 +2776,33 @@ void Element::AdvanceAnimations()
 	}
 }
 
+const Property* Element::GetCompositedProperty(PropertyId id) const
+{
+	if (composited_animations)
+	{
+		if (Context* context = GetContext())
+			return context->compositor->GetProperty(this, id);
+	}
+	return nullptr;
+}
+
+void Element::ReclaimCompositedAnimations()
+{
+	if (composited_animations)
+	{
+		if (Context* context = GetContext())
+			context->compositor->ReturnAnimations(this);
+	}
+}
+
 
+void Element::DirtyDecoratorsRecursive()
+{
+	meta->decoration.DirtyDecorators();
+
+	for (ElementPtr& child : children)
+		child->DirtyDecoratorsRecursive();
+}
 
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
@@ -2662,13 +2882,18 @@ void Element::UpdateTransformState()
 		bool have_transform = false;
 		Matrix4f transform = Matrix4f::Identity();
 
-		if (computed.transform)
+		// A transform animated by the compositor takes the place of the computed one.
+		TransformPtr local_transform = computed.transform;
+		if (const Property* composited_transform = GetCompositedProperty(PropertyId::Transform))
+			local_transform = composited_transform->Get<TransformPtr>();
+
+		if (local_transform)
 		{
 			// First find the current element's transform
-			const int n = computed.transform->GetNumPrimitives();
+			const int n = local_transform->GetNumPrimitives();
 			for (int i = 0; i < n; ++i)
 			{
-				const TransformPrimitive& primitive = computed.transform->GetPrimitive(i);
+				const TransformPrimitive& primitive = local_transform->GetPrimitive(i);
 				Matrix4f matrix = TransformUtilities::ResolveTransform(primitive, *this);
 				transform *= matrix;
 				have_transform = true;
@@ -2729,6 +2954,10 @@ void Element::UpdateTransformState()
 			transform_state->SetTransform(nullptr);
 
 		perspective_or_transform_changed |= (had_transform != have_transform);
+
+		// Transformed elements are tested for every point, they can not be binned by their boxes.
+		if (had_transform != have_transform)
+			DirtyHitTest();
 	}
 
 	// A change in perspective or transform will require an update to children transforms as well.
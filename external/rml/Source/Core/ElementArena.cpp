@@ -0,0 +1,197 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ElementArena.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/MemoryInterface.h"
+#include <algorithm>
+#include <stdlib.h>
+
+namespace Rml {
+
+thread_local ElementArena* ElementArena::construction_arena = nullptr;
+
+ElementArena::ElementArena() : memory_interface(GetMemoryInterface())
+{
+}
+
+ElementArena::~ElementArena()
+{
+	RMLUI_ASSERT(IsUnused());
+
+	for (void* block : blocks)
+	{
+		if (memory_interface)
+			memory_interface->Deallocate(block);
+		else
+			free(block);
+	}
+}
+
+ElementArena* ElementArena::Create()
+{
+	MemoryInterface* memory_interface = GetMemoryInterface();
+	void* memory = (memory_interface ? memory_interface->Allocate(sizeof(ElementArena), alignof(ElementArena)) : malloc(sizeof(ElementArena)));
+	return new (memory) ElementArena();
+}
+
+void ElementArena::Destroy()
+{
+	MemoryInterface* arena_memory_interface = memory_interface;
+	this->~ElementArena();
+
+	if (arena_memory_interface)
+		arena_memory_interface->Deallocate(this);
+	else
+		free(this);
+}
+
+ElementArena* ElementArena::GetArena(Element* parent)
+{
+	ElementDocument* document = (parent ? parent->GetOwnerDocument() : nullptr);
+	if (!document)
+		return nullptr;
+
+	if (!document->arena)
+		document->arena = Create();
+
+	return document->arena;
+}
+
+ElementArena* ElementArena::GetOwner(const Element* element)
+{
+	return element->arena;
+}
+
+ElementArena* ElementArena::ReleaseConstructionArena()
+{
+	ElementArena* arena = construction_arena;
+	construction_arena = nullptr;
+	return arena;
+}
+
+void* ElementArena::Allocate(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	size = (size + Alignment - 1) & ~(Alignment - 1);
+	num_live_allocations++;
+	num_live_bytes += size;
+
+	auto it = std::find_if(free_lists.begin(), free_lists.end(), [size](const FreeList& list) { return list.size == size; });
+	if (it != free_lists.end() && it->first)
+	{
+		FreeNode* node = it->first;
+		it->first = node->next;
+		return node;
+	}
+
+	if (block_cursor + size > block_end)
+	{
+		// Objects larger than a block get a block of their own, the rest of the current block is left unused.
+		const size_t block_size = std::max(size, BlockSize);
+		void* block = (memory_interface ? memory_interface->Allocate(block_size, Alignment) : malloc(block_size));
+		blocks.push_back(block);
+		num_reserved_bytes += block_size;
+
+		block_cursor = static_cast<byte*>(block);
+		block_end = block_cursor + block_size;
+	}
+
+	void* ptr = block_cursor;
+	block_cursor += size;
+	return ptr;
+}
+
+void ElementArena::Deallocate(void* ptr, size_t size)
+{
+	bool unused = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		size = (size + Alignment - 1) & ~(Alignment - 1);
+		RMLUI_ASSERT(num_live_allocations > 0 && num_live_bytes >= size);
+		num_live_allocations--;
+		num_live_bytes -= size;
+
+		auto it = std::find_if(free_lists.begin(), free_lists.end(), [size](const FreeList& list) { return list.size == size; });
+		if (it == free_lists.end())
+		{
+			free_lists.push_back(FreeList{ size, nullptr });
+			it = free_lists.end() - 1;
+		}
+
+		FreeNode* node = static_cast<FreeNode*>(ptr);
+		node->next = it->first;
+		it->first = node;
+
+		unused = IsUnused();
+	}
+
+	if (unused)
+		Destroy();
+}
+
+void ElementArena::ReleaseDocument()
+{
+	bool unused = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		document_alive = false;
+		unused = IsUnused();
+	}
+
+	if (unused)
+		Destroy();
+}
+
+bool ElementArena::IsUnused() const
+{
+	return !document_alive && num_live_allocations == 0;
+}
+
+size_t ElementArena::GetNumLiveBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return num_live_bytes;
+}
+
+int ElementArena::GetNumLiveAllocations() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return num_live_allocations;
+}
+
+size_t ElementArena::GetNumReservedBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return num_reserved_bytes;
+}
+
+} // namespace Rml
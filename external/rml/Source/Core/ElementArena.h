@@ -0,0 +1,145 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ELEMENTARENA_H
+#define RMLUI_CORE_ELEMENTARENA_H
+
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <cstddef>
+#include <mutex>
+
+namespace Rml {
+
+class MemoryInterface;
+
+/**
+	Allocates the elements of a document, and their meta data, from memory blocks requested through the memory interface.
+
+	Released objects are kept in free lists by size, so that elements created and destroyed while the document is open
+	reuse the same memory. The blocks are returned in one go once the document and all the elements allocated from the
+	arena are gone.
+ */
+
+class ElementArena : public NonCopyMoveable
+{
+public:
+	/// Returns the arena for new elements placed below the given parent.
+	/// @return The arena of the parent's document, or nullptr if the parent is not part of a document.
+	static ElementArena* GetArena(Element* parent);
+	/// Returns the arena the element was allocated from, or nullptr if it was allocated elsewhere.
+	static ElementArena* GetOwner(const Element* element);
+	/// Returns the arena of the element being constructed on the calling thread, and clears it.
+	static ElementArena* ReleaseConstructionArena();
+
+	/// Constructs an element in this arena.
+	template<typename T>
+	T* ConstructElement(const String& tag);
+	/// Destroys an element constructed in this arena.
+	template<typename T>
+	void DestroyElement(T* element);
+
+	/// Allocates memory from the arena, each allocation keeps the arena alive until it is deallocated.
+	void* Allocate(size_t size);
+	/// Returns memory to the arena.
+	void Deallocate(void* ptr, size_t size);
+
+	/// Releases the reference held by the owning document.
+	void ReleaseDocument();
+
+	/// Returns the number of bytes currently allocated from the arena.
+	size_t GetNumLiveBytes() const;
+	/// Returns the number of objects currently allocated from the arena.
+	int GetNumLiveAllocations() const;
+	/// Returns the number of bytes in the blocks reserved by the arena.
+	size_t GetNumReservedBytes() const;
+
+private:
+	ElementArena();
+	~ElementArena();
+
+	// Allocates and frees the arena itself through the memory interface.
+	static ElementArena* Create();
+	void Destroy();
+
+	// Returns true if neither the document nor any allocation refers to the arena anymore.
+	bool IsUnused() const;
+
+	static constexpr size_t Alignment = alignof(std::max_align_t);
+	static constexpr size_t BlockSize = 32 * 1024;
+
+	struct FreeNode {
+		FreeNode* next;
+	};
+	struct FreeList {
+		size_t size;
+		FreeNode* first;
+	};
+
+	MemoryInterface* memory_interface;
+
+	Vector<void*> blocks;
+	byte* block_cursor = nullptr;
+	byte* block_end = nullptr;
+	Vector<FreeList> free_lists;
+
+	bool document_alive = true;
+	int num_live_allocations = 0;
+	size_t num_live_bytes = 0;
+	size_t num_reserved_bytes = 0;
+
+	// Elements of a document are usually created and destroyed on the thread updating its context, then the lock is uncontended.
+	mutable std::mutex mutex;
+
+	static thread_local ElementArena* construction_arena;
+};
+
+template<typename T>
+T* ElementArena::ConstructElement(const String& tag)
+{
+	static_assert(alignof(T) <= Alignment, "Element type is over-aligned for the arena.");
+	void* ptr = Allocate(sizeof(T));
+
+	// The element constructor picks up the arena to allocate its meta data from.
+	construction_arena = this;
+	T* element = new (ptr) T(tag);
+	RMLUI_ASSERT(construction_arena == nullptr);
+
+	return element;
+}
+
+template<typename T>
+void ElementArena::DestroyElement(T* element)
+{
+	element->~T();
+	Deallocate(element, sizeof(T));
+}
+
+} // namespace Rml
+#endif
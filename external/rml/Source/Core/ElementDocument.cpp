@@ -34,6 +34,7 @@
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "DocumentHeader.h"
+#include "ElementArena.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
 #include "LayoutEngine.h"
@@ -42,6 +43,7 @@
 #include "Template.h"
 #include "TemplateCache.h"
 #include "XMLParseTools.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -63,6 +65,9 @@ ElementDocument::ElementDocument(const String& tag) : Element(tag)
 
 ElementDocument::~ElementDocument()
 {
+	// The arena is kept alive by elements still allocated from it, in particular our children which are destroyed after this.
+	if (arena)
+		arena->ReleaseDocument();
 }
 
 void ElementDocument::ProcessHeader(const DocumentHeader* document_header)
@@ -95,12 +100,12 @@ void ElementDocument::ProcessHeader(const DocumentHeader* document_header)
 
 	// If a style-sheet (or sheets) has been specified for this element, then we load them and set the combined sheet
 	// on the element; all of its children will inherit it by default.
-	SharedPtr<StyleSheet> new_style_sheet;
-	if (header.rcss_external.size() > 0)
+	SharedPtr<StyleSheet> new_style_sheet = document_header->style_sheet;
+	if (!new_style_sheet && header.rcss_external.size() > 0)
 		new_style_sheet = StyleSheetFactory::GetStyleSheet(header.rcss_external);
 
-	// Combine any inline sheets.
-	for (size_t i = 0; i < header.rcss_inline.size(); i++)
+	// Combine any inline sheets, unless we reuse the combined sheet from the document cache.
+	for (size_t i = 0; !document_header->style_sheet && i < header.rcss_inline.size(); i++)
 	{
 		UniquePtr<StyleSheet> inline_sheet = MakeUnique<StyleSheet>();
 		auto stream = MakeUnique<StreamMemory>((const byte*)header.rcss_inline[i].c_str(), header.rcss_inline[i].size());
@@ -358,10 +363,55 @@ void ElementDocument::UpdateDocument()
 }
 
 // Updates the layout if necessary.
-void ElementDocument::UpdateLayout()
+int ElementDocument::UpdateLayout()
 {
 	// Note: Carefully consider when to call this function for performance reasons.
 	// Ideally, only called once per update loop.
+	int num_layout_roots = 0;
+
+	if (!layout_dirty && !dirty_layout_boundaries.empty())
+	{
+		RMLUI_ZoneScopedN("UpdateLayoutBoundaries");
+
+		for (const ObserverPtr<Element>& boundary_ptr : dirty_layout_boundaries)
+		{
+			// Boundaries which were removed or moved to another document have already dirtied the layout of their old parent.
+			Element* boundary = boundary_ptr.get();
+			if (!boundary || boundary->GetOwnerDocument() != this)
+				continue;
+
+			// The boundary may have changed since it was dirtied, then we can't tell which part of the document is affected.
+			if (!LayoutEngine::IsLayoutBoundary(boundary))
+			{
+				layout_dirty = true;
+				break;
+			}
+
+			// Boundaries inside hidden elements are not formatted, and boundaries inside other dirty boundaries are formatted along with them.
+			bool skip = false;
+			for (Element* ancestor = boundary->GetParentNode(); ancestor && ancestor != this && !skip; ancestor = ancestor->GetParentNode())
+			{
+				skip = (ancestor->GetDisplay() == Style::Display::None || std::any_of(dirty_layout_boundaries.begin(), dirty_layout_boundaries.end(),
+					[ancestor](const ObserverPtr<Element>& other) { return other.get() == ancestor; }));
+			}
+			if (skip)
+				continue;
+
+			// The size and position of the boundary are unchanged, only its contents are formatted again.
+			LayoutEngine::FormatElement(boundary, boundary->GetParentNode()->GetBox().GetSize(), &boundary->GetBox());
+			num_layout_roots++;
+		}
+
+		if (!layout_dirty)
+		{
+			if (context)
+				context->SetRenderDirty();
+
+			// Ignore any layout dirtied during formatting, as below.
+			dirty_layout_boundaries.clear();
+		}
+	}
+
 	if(layout_dirty)
 	{
 		RMLUI_ZoneScoped;
@@ -373,10 +423,17 @@ void ElementDocument::UpdateLayout()
 
 		LayoutEngine::FormatElement(this, containing_block);
 
+		if (context)
+			context->SetRenderDirty();
+
 		// Ignore dirtied layout during document formatting. Layouting must not require re-iteration.
 		// In particular, scrollbars being enabled may set the dirty flag, but this case is already handled within the layout engine.
 		layout_dirty = false;
+		dirty_layout_boundaries.clear();
+		num_layout_roots++;
 	}
+
+	return num_layout_roots;
 }
 
 // Updates the position of the document based on the style properties.
@@ -388,6 +445,9 @@ void ElementDocument::UpdatePosition()
 
 		position_dirty = false;
 
+		if (context)
+			context->SetRenderDirty();
+
 		Element* root = GetParentNode();
 
 		// We only position ourselves if we are a child of our context's root element. That is, we don't want to proceed if we are unparented or an iframe document.
@@ -428,6 +488,21 @@ void ElementDocument::DirtyLayout()
 	layout_dirty = true;
 }
 
+void ElementDocument::DirtyLayoutBoundary(Element* boundary)
+{
+	// Formatting the whole document includes the boundary.
+	if (layout_dirty)
+		return;
+
+	for (const ObserverPtr<Element>& other : dirty_layout_boundaries)
+	{
+		if (other.get() == boundary)
+			return;
+	}
+
+	dirty_layout_boundaries.push_back(boundary->GetObserverPtr());
+}
+
 bool ElementDocument::IsLayoutDirty()
 {
 	return layout_dirty;
@@ -28,8 +28,10 @@
 
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
+#include "ElementArena.h"
 #include "XMLParseTools.h"
 #include "Pool.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -39,17 +41,38 @@ ElementInstancer::~ElementInstancer()
 
 static Pool< Element > pool_element(200, true);
 static Pool< ElementText > pool_text_default(200, true);
+// Contexts may be updated from multiple threads, and elements may be created and destroyed during updates.
+// The lock only guards the pools, elements are constructed and destroyed outside of it since that creates and releases
+// other elements and their meta data.
+static std::mutex pool_mutex;
 
 
-ElementPtr ElementInstancerElement::InstanceElement(Element* /*parent*/, const String& tag, const XMLAttributes& /*attributes*/)
+ElementPtr ElementInstancerElement::InstanceElement(Element* parent, const String& tag, const XMLAttributes& /*attributes*/)
 {
-	Element* ptr = pool_element.AllocateAndConstruct(tag);
-	return ElementPtr(ptr);
+	// Elements created inside a document are allocated from its arena, the global pools are only used for detached elements.
+	if (ElementArena* arena = ElementArena::GetArena(parent))
+		return ElementPtr(arena->ConstructElement<Element>(tag));
+
+	void* memory;
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		memory = pool_element.Allocate();
+	}
+	return ElementPtr(new (memory) Element(tag));
 }
 
 void ElementInstancerElement::ReleaseElement(Element* element)
 {
-	pool_element.DestroyAndDeallocate(element);
+	if (ElementArena* arena = ElementArena::GetOwner(element))
+	{
+		arena->DestroyElement(element);
+		return;
+	}
+
+	element->~Element();
+
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	pool_element.Deallocate(element);
 }
 
 ElementInstancerElement::~ElementInstancerElement()
@@ -66,15 +89,32 @@ ElementInstancerElement::~ElementInstancerElement()
 	}
 }
 
-ElementPtr ElementInstancerText::InstanceElement(Element* /*parent*/, const String& tag, const XMLAttributes& /*attributes*/)
+ElementPtr ElementInstancerText::InstanceElement(Element* parent, const String& tag, const XMLAttributes& /*attributes*/)
 {
-	ElementText* ptr = pool_text_default.AllocateAndConstruct(tag);
-	return ElementPtr(static_cast<Element*>(ptr));
+	if (ElementArena* arena = ElementArena::GetArena(parent))
+		return ElementPtr(static_cast<Element*>(arena->ConstructElement<ElementText>(tag)));
+
+	void* memory;
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		memory = pool_text_default.Allocate();
+	}
+	return ElementPtr(static_cast<Element*>(new (memory) ElementText(tag)));
 }
 
 void ElementInstancerText::ReleaseElement(Element* element)
 {
-	pool_text_default.DestroyAndDeallocate(static_cast<ElementText*>(element));
+	if (ElementArena* arena = ElementArena::GetOwner(element))
+	{
+		arena->DestroyElement(static_cast<ElementText*>(element));
+		return;
+	}
+
+	ElementText* element_text = static_cast<ElementText*>(element);
+	element_text->~ElementText();
+
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	pool_text_default.Deallocate(element_text);
 }
 
 } // namespace Rml
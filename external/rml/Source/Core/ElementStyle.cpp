@@ -56,6 +56,7 @@ ElementStyle::ElementStyle(Element* _element)
 	element = _element;
 
 	definition_dirty = true;
+	child_definitions_dirty = true;
 }
 
 const ElementDefinition* ElementStyle::GetDefinition() const
@@ -128,7 +129,10 @@ void ElementStyle::TransitionPropertyChanges(Element* element, PropertyIdSet& pr
 
 			auto add_transition = [&](const Transition& transition) {
 				bool transition_added = false;
-				const Property* start_value = GetProperty(transition.id, element, inline_properties, old_definition);
+				// Values animated by the compositor are not set on the element, so they are taken from the compositor instead.
+				const Property* start_value = element->GetCompositedProperty(transition.id);
+				if (!start_value)
+					start_value = GetProperty(transition.id, element, inline_properties, old_definition);
 				const Property* target_value = GetProperty(transition.id, element, empty_properties, new_definition);
 				if (start_value && target_value && (*start_value != *target_value))
 					transition_added = element->StartTransition(transition, *start_value, *target_value);
@@ -211,8 +215,13 @@ void ElementStyle::UpdateDefinition()
 		}
 
 		// Even if the definition was not changed, the child definitions may have changed as a result of anything that
-		// could change the definition of this element, such as a new pseudo class.
-		DirtyChildDefinitions();
+		// could change the definition of this element, such as a new pseudo class. Skipped when the change is known to
+		// only affect selectors matching this element itself.
+		if (child_definitions_dirty)
+		{
+			child_definitions_dirty = false;
+			DirtyChildDefinitions();
+		}
 	}
 }
 
@@ -230,7 +239,7 @@ void ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate)
 
 	if (changed)
 	{
-		DirtyDefinition();
+		DirtyDefinitionForSelector(pseudo_class, true);
 	}
 }
 
@@ -255,7 +264,7 @@ void ElementStyle::SetClass(const String& class_name, bool activate)
 		if (class_location == classes.end())
 		{
 			classes.push_back(class_name);
-			DirtyDefinition();
+			DirtyDefinitionForSelector(class_name, false);
 		}
 	}
 	else
@@ -263,7 +272,7 @@ void ElementStyle::SetClass(const String& class_name, bool activate)
 		if (class_location != classes.end())
 		{
 			classes.erase(class_location);
-			DirtyDefinition();
+			DirtyDefinitionForSelector(class_name, false);
 		}
 	}
 }
@@ -277,9 +286,22 @@ bool ElementStyle::IsClassSet(const String& class_name) const
 // Specifies the entire list of classes for this element. This will replace any others specified.
 void ElementStyle::SetClassNames(const String& class_names)
 {
-	classes.clear();
-	StringUtilities::ExpandString(classes, class_names, ' ');
-	DirtyDefinition();
+	StringList new_classes;
+	StringUtilities::ExpandString(new_classes, class_names, ' ');
+
+	// Only the classes which were added or removed can change the definition.
+	for (const String& class_name : classes)
+	{
+		if (std::find(new_classes.begin(), new_classes.end(), class_name) == new_classes.end())
+			DirtyDefinitionForSelector(class_name, false);
+	}
+	for (const String& class_name : new_classes)
+	{
+		if (std::find(classes.begin(), classes.end(), class_name) == classes.end())
+			DirtyDefinitionForSelector(class_name, false);
+	}
+
+	classes = std::move(new_classes);
 }
 
 // Returns the list of classes specified for this element.
@@ -298,6 +320,11 @@ String ElementStyle::GetClassNames() const
 	return class_names;
 }
 
+const StringList& ElementStyle::GetClassNameList() const
+{
+	return classes;
+}
+
 // Sets a local property override on the element to a pre-parsed value.
 bool ElementStyle::SetProperty(PropertyId id, const Property& property)
 {
@@ -430,6 +457,30 @@ float ElementStyle::ResolveLength(const Property* property, RelativeTarget relat
 void ElementStyle::DirtyDefinition()
 {
 	definition_dirty = true;
+	child_definitions_dirty = true;
+}
+
+void ElementStyle::DirtyDefinitionForSelector(const String& name, bool is_pseudo_class)
+{
+	const StyleSheet* style_sheet = element->GetStyleSheet().get();
+	if (!style_sheet)
+	{
+		DirtyDefinition();
+		return;
+	}
+
+	const StyleSheet::SelectorDependency dependency = (is_pseudo_class ? style_sheet->GetPseudoClassDependency(name) : style_sheet->GetClassDependency(name));
+	switch (dependency)
+	{
+	case StyleSheet::SelectorDependency::None:
+		break;
+	case StyleSheet::SelectorDependency::Self:
+		definition_dirty = true;
+		break;
+	case StyleSheet::SelectorDependency::SelfAndDescendants:
+		DirtyDefinition();
+		break;
+	}
 }
 
 void ElementStyle::DirtyInheritedProperties()
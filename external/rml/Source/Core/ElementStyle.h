@@ -83,6 +83,8 @@ public:
 	/// Return the active class list.
 	/// @return A string containing all the classes on the element, separated by spaces.
 	String GetClassNames() const;
+	/// Return the active class list.
+	const StringList& GetClassNameList() const;
 
 	/// Sets a local property override on the element to a pre-parsed value.
 	/// @param[in] name The name of the new property.
@@ -139,6 +141,9 @@ public:
 private:
 	// Dirty all child definitions
 	void DirtyChildDefinitions();
+	// Dirty the definition of this element and, if needed, its children after the given class or pseudo class changed.
+	// Nothing is dirtied if no selector in the style sheet refers to the name.
+	void DirtyDefinitionForSelector(const String& name, bool is_pseudo_class);
 	// Sets a single property as dirty.
 	void DirtyProperty(PropertyId id);
 	// Sets a list of properties as dirty.
@@ -162,6 +167,8 @@ private:
 	SharedPtr<ElementDefinition> definition;
 	// Set if a new element definition should be fetched from the style.
 	bool definition_dirty;
+	// Set if the children definitions should be dirtied when the definition is updated.
+	bool child_definitions_dirty;
 
 	PropertyIdSet dirty_properties;
 };
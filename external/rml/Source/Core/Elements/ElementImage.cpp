@@ -158,8 +158,8 @@ void ElementImage::GenerateGeometry()
 	// Release the old geometry before specifying the new vertices.
 	geometry.Release(true);
 
-	Vector< Vertex >& vertices = geometry.GetVertices();
-	Vector< int >& indices = geometry.GetIndices();
+	MemoryVector< Vertex >& vertices = geometry.GetVertices();
+	MemoryVector< int >& indices = geometry.GetIndices();
 
 	vertices.resize(4);
 	indices.resize(6);
@@ -29,6 +29,7 @@
 #include "WidgetTextInput.h"
 #include "ElementTextSelection.h"
 #include "../../../Include/RmlUi/Core/Elements/ElementFormControl.h"
+#include "../../../Include/RmlUi/Core/Context.h"
 #include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/ElementScroll.h"
 #include "../../../Include/RmlUi/Core/ElementText.h"
@@ -224,6 +225,9 @@ void WidgetTextInput::OnUpdate()
 		{
 			cursor_timer += CURSOR_BLINK_TIME;
 			cursor_visible = !cursor_visible;
+
+			if (Context* context = parent->GetContext())
+				context->SetRenderDirty();
 		}
 	}
 }
@@ -982,8 +986,8 @@ Vector2f WidgetTextInput::FormatText()
 	// Clear the selection background geometry, and get the vertices and indices so the new geo can
 	// be generated.
 	selection_geometry.Release(true);
-	Vector< Vertex >& selection_vertices = selection_geometry.GetVertices();
-	Vector< int >& selection_indices = selection_geometry.GetIndices();
+	MemoryVector< Vertex >& selection_vertices = selection_geometry.GetVertices();
+	MemoryVector< int >& selection_indices = selection_geometry.GetIndices();
 
 	// Determine the line-height of the text element.
 	float line_height = parent->GetLineHeight();
@@ -1114,10 +1118,10 @@ void WidgetTextInput::GenerateCursor()
 	// Generates the cursor.
 	cursor_geometry.Release();
 
-	Vector< Vertex >& vertices = cursor_geometry.GetVertices();
+	MemoryVector< Vertex >& vertices = cursor_geometry.GetVertices();
 	vertices.resize(4);
 
-	Vector< int >& indices = cursor_geometry.GetIndices();
+	MemoryVector< int >& indices = cursor_geometry.GetIndices();
 	indices.resize(6);
 
 	cursor_size.x = ElementUtilities::GetDensityIndependentPixelRatio(text_element);
@@ -28,6 +28,7 @@
 
 #include "EventSpecification.h"
 #include "../../Include/RmlUi/Core/ID.h"
+#include <mutex>
 
 
 namespace Rml {
@@ -38,6 +39,9 @@ static Vector<EventSpecification> specifications = { { EventId::Invalid, "invali
 // Reverse lookup map from event type to id.
 static UnorderedMap<String, EventId> type_lookup;
 
+// Custom event types may be inserted while updating contexts, which may happen on multiple threads.
+static std::recursive_mutex specifications_mutex;
+
 
 namespace EventSpecificationInterface {
 
@@ -87,6 +91,9 @@ void Initialize()
 		{EventId::Rowupdate     , "rowupdate"     , false , true  , DefaultActionPhase::None},
 	};
 
+	// Keep references to the specifications valid when custom events are inserted.
+	specifications.reserve(size_t(EventId::MaxNumIds));
+
 	type_lookup.clear();
 	type_lookup.reserve(specifications.size());
 	for (auto& specification : specifications)
@@ -116,6 +123,7 @@ static EventSpecification& GetMutable(EventId id)
 // If not found: Inserts a new entry with given values.
 static EventSpecification& GetOrInsert(const String& event_type, bool interruptible, bool bubbles, DefaultActionPhase default_action_phase)
 {
+	std::lock_guard<std::recursive_mutex> lock(specifications_mutex);
 	auto it = type_lookup.find(event_type);
 
 	if (it != type_lookup.end())
@@ -138,6 +146,7 @@ static EventSpecification& GetOrInsert(const String& event_type, bool interrupti
 
 const EventSpecification& Get(EventId id)
 {
+	std::lock_guard<std::recursive_mutex> lock(specifications_mutex);
 	return GetMutable(id);
 }
 
@@ -153,6 +162,7 @@ const EventSpecification& GetOrInsert(const String& event_type)
 
 EventId GetIdOrInsert(const String& event_type)
 {
+	std::lock_guard<std::recursive_mutex> lock(specifications_mutex);
 	auto it = type_lookup.find(event_type);
 	if (it != type_lookup.end())
 		return it->second;
@@ -162,6 +172,7 @@ EventId GetIdOrInsert(const String& event_type)
 
 EventId InsertOrReplaceCustom(const String& event_type, bool interruptible, bool bubbles, DefaultActionPhase default_action_phase)
 {
+	std::lock_guard<std::recursive_mutex> lock(specifications_mutex);
 	const size_t size_before = specifications.size();
 	EventSpecification& specification = GetOrInsert(event_type, interruptible, bubbles, default_action_phase);
 	bool got_existing_entry = (size_before == specifications.size());
@@ -61,6 +61,7 @@
 #include "DecoratorTiledVerticalInstancer.h"
 #include "DecoratorNinePatch.h"
 #include "DecoratorGradient.h"
+#include "DocumentHeader.h"
 #include "ElementHandle.h"
 #include "EventInstancerDefault.h"
 #include "FontEffectBlur.h"
@@ -124,6 +125,34 @@ static EventInstancer* event_instancer = nullptr;
 // Event listener instancer.
 static EventListenerInstancer* event_listener_instancer = nullptr;
 
+// Parsed documents, so that loading the same document again replays the parse instead of reading the RML and RCSS.
+// Replay still instances the whole element tree, so only the most recently loaded documents are kept.
+struct CachedDocument {
+	size_t content_hash = 0;
+	size_t last_used = 0;
+	SharedPtr<const XMLRecording> recording;
+	SharedPtr<StyleSheet> style_sheet;
+};
+using DocumentCache = UnorderedMap< String, CachedDocument >;
+static DocumentCache document_cache;
+static size_t document_cache_use_counter = 0;
+static constexpr size_t document_cache_max_entries = 32;
+
+// Drops the least recently used documents until the cache is within its budget.
+static void EvictDocumentCache()
+{
+	while (document_cache.size() > document_cache_max_entries)
+	{
+		auto it_lru = document_cache.begin();
+		for (auto it = document_cache.begin(); it != document_cache.end(); ++it)
+		{
+			if (it->second.last_used < it_lru->second.last_used)
+				it_lru = it;
+		}
+		document_cache.erase(it_lru);
+	}
+}
+
 // Default instancers are constructed and destroyed on Initialise and Shutdown, respectively.
 struct DefaultInstancers {
 
@@ -301,6 +330,8 @@ void Factory::Shutdown()
 	structural_data_view_instancers.clear();
 	structural_data_view_attribute_names.clear();
 
+	document_cache.clear();
+
 	context_instancer = nullptr;
 
 	event_listener_instancer = nullptr;
@@ -489,8 +520,35 @@ ElementPtr Factory::InstanceDocumentStream(Context* context, Stream* stream)
 
 	document->context = context;
 
+	// Documents are cached by their source and contents, so modified files are parsed again.
+	String content;
+	stream->Read(content, stream->Length());
+	const size_t content_hash = Hash<String>()(content);
+
 	XMLParser parser(element.get());
-	parser.Parse(stream);
+
+	auto it = document_cache.find(stream->GetSourceURL().GetURL());
+	if (it != document_cache.end() && it->second.content_hash == content_hash)
+	{
+		it->second.last_used = ++document_cache_use_counter;
+		parser.GetDocumentHeader()->style_sheet = it->second.style_sheet;
+
+		// Keep the recording alive, the handlers may load other documents which evict this one.
+		const SharedPtr<const XMLRecording> recording = it->second.recording;
+		parser.Replay(stream->GetSourceURL(), *recording);
+		return element;
+	}
+
+	SharedPtr<XMLRecording> recording = MakeShared<XMLRecording>();
+	stream->Seek(0, SEEK_SET);
+	parser.Parse(stream, *recording);
+
+	CachedDocument& cached_document = document_cache[stream->GetSourceURL().GetURL()];
+	cached_document.content_hash = content_hash;
+	cached_document.last_used = ++document_cache_use_counter;
+	cached_document.recording = std::move(recording);
+	cached_document.style_sheet = document->GetStyleSheet();
+	EvictDocumentCache();
 
 	return element;
 }
@@ -560,12 +618,20 @@ SharedPtr<StyleSheet> Factory::InstanceStyleSheetStream(Stream* stream)
 void Factory::ClearStyleSheetCache()
 {
 	StyleSheetFactory::ClearStyleSheetCache();
+	document_cache.clear();
 }
 
 /// Clears the template cache. This will force templates to be reloaded.
 void Factory::ClearTemplateCache()
 {
 	TemplateCache::Clear();
+	document_cache.clear();
+}
+
+// Clears the document cache. This will force documents to be parsed again.
+void Factory::ClearDocumentCache()
+{
+	document_cache.clear();
 }
 
 // Registers an instancer for all RmlEvents
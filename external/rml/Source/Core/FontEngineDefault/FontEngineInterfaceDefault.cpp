@@ -29,9 +29,14 @@
 #include "FontProvider.h"
 #include "FontFaceHandleDefault.h"
 #include "FontEngineInterfaceDefault.h"
+#include <mutex>
 
 namespace Rml {
 
+// Font faces lazily generate glyphs, kerning and layers, and are shared by all contexts. Contexts may be updated on
+// multiple threads, so calls which can modify them are serialized. The font metrics never change after creation.
+static std::mutex font_engine_mutex;
+
 FontEngineInterfaceDefault::FontEngineInterfaceDefault()
 {
 	FontProvider::Initialise();
@@ -44,22 +49,26 @@ FontEngineInterfaceDefault::~FontEngineInterfaceDefault()
 
 bool FontEngineInterfaceDefault::LoadFontFace(const String& file_name, bool fallback_face)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(file_name, fallback_face);
 }
 
 bool FontEngineInterfaceDefault::LoadFontFace(const byte* data, int data_size, const String& font_family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(data, data_size, font_family, style, weight, fallback_face);
 }
 
 FontFaceHandle FontEngineInterfaceDefault::GetFontFaceHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle = FontProvider::GetFontFaceHandle(family, style, weight, size);
 	return reinterpret_cast<FontFaceHandle>(handle);
 }
 	
 FontEffectsHandle FontEngineInterfaceDefault::PrepareFontEffects(FontFaceHandle handle, const FontEffectList& font_effects)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
 	return (FontEffectsHandle)handle_default->GenerateLayerConfiguration(font_effects);
 }
@@ -96,6 +105,7 @@ float FontEngineInterfaceDefault::GetUnderline(FontFaceHandle handle, float& thi
 
 int FontEngineInterfaceDefault::GetStringWidth(FontFaceHandle handle, const String& string, Character prior_character)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
 	return handle_default->GetStringWidth(string, prior_character);
 }
@@ -103,14 +113,31 @@ int FontEngineInterfaceDefault::GetStringWidth(FontFaceHandle handle, const Stri
 int FontEngineInterfaceDefault::GenerateString(FontFaceHandle handle, FontEffectsHandle font_effects_handle, const String& string,
 	const Vector2f& position, const Colourb& colour, GeometryList& geometry)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
 	return handle_default->GenerateString(geometry, string, position, colour, (int)font_effects_handle);
 }
 
 int FontEngineInterfaceDefault::GetVersion(FontFaceHandle handle)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GetVersion();
 }
 
+void FontEngineInterfaceDefault::PrepareGlyphs(FontFaceHandle handle, const String& characters)
+{
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
+	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
+	handle_default->PrepareGlyphs(characters);
+}
+
+FontAtlasStatistics FontEngineInterfaceDefault::GetAtlasStatistics()
+{
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
+	FontAtlasStatistics statistics;
+	FontProvider::AddAtlasStatistics(statistics);
+	return statistics;
+}
+
 } // namespace Rml
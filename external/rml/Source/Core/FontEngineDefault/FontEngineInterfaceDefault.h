@@ -73,6 +73,12 @@ public:
 
 	/// Returns the current version of the font face.
 	int GetVersion(FontFaceHandle handle) override;
+
+	/// Generates the glyphs of the given characters in all the layers of the font face.
+	void PrepareGlyphs(FontFaceHandle handle, const String& characters) override;
+
+	/// Returns the glyph and texture usage of all font faces.
+	FontAtlasStatistics GetAtlasStatistics() override;
 };
 
 } // namespace Rml
@@ -92,5 +92,15 @@ FontFaceHandleDefault* FontFace::GetHandle(int size) {
 	return result;
 }
 
+void FontFace::AddAtlasStatistics(FontAtlasStatistics& statistics) const
+{
+	for (const auto& pair : handles)
+	{
+		// Failed handles are stored as null so that we do not try to create them again.
+		if (pair.second)
+			pair.second->AddAtlasStatistics(statistics);
+	}
+}
+
 
 } // namespace Rml
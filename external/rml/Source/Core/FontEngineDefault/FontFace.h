@@ -54,6 +54,9 @@ public:
 	/// @return The font handle.
 	FontFaceHandleDefault* GetHandle(int size);
 
+	/// Adds the glyph and texture usage of the face's handles to the statistics.
+	void AddAtlasStatistics(FontAtlasStatistics& statistics) const;
+
 private:
 	Style::FontStyle style;
 	Style::FontWeight weight;
@@ -192,14 +192,8 @@ int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font
 }
 
 // Generates the texture data for a layer (for the texture database).
-bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id, int handle_version) const
+bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id) const
 {
-	if (handle_version != version)
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Handle version mismatch in texture vs font-face.");
-		return false;
-	}
-
 	auto it = std::find_if(layers.begin(), layers.end(), [font_effect](const EffectLayerPair& pair) { return pair.font_effect == font_effect; });
 
 	if (it == layers.end())
@@ -208,7 +202,7 @@ bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& textur
 		return false;
 	}
 
-	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, glyphs);
+	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id);
 }
 
 // Generates the geometry required to render a single line of text.
@@ -290,13 +284,13 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 {
 	bool result = false;
 
-	// If we are dirty, regenerate all the layers and increment the version
+	// If we are dirty, add the new glyphs to all the layers and increment the version
 	if(is_layers_dirty && base_layer)
 	{
 		is_layers_dirty = false;
 		++version;
 
-		// Regenerate all the layers.
+		// Update all the layers, only the new glyphs are rendered.
 		// Note: The layer regeneration needs to happen in the order in which the layers were created,
 		// otherwise we may end up cloning a layer which has not yet been regenerated. This means trouble!
 		for (auto& pair : layers)
@@ -315,6 +309,33 @@ int FontFaceHandleDefault::GetVersion() const
 	return version;
 }
 
+void FontFaceHandleDefault::PrepareGlyphs(const String& characters)
+{
+	for (auto it_string = StringIteratorU8(characters); it_string; ++it_string)
+	{
+		Character character = *it_string;
+		GetOrAppendGlyph(character);
+	}
+
+	UpdateLayersOnDirty();
+}
+
+void FontFaceHandleDefault::AddAtlasStatistics(FontAtlasStatistics& statistics) const
+{
+	statistics.num_font_face_handles += 1;
+	statistics.num_glyphs += (int)glyphs.size();
+
+	for (const EffectLayerPair& pair : layers)
+	{
+		const size_t texture_memory = pair.layer->GetTextureMemory();
+		if (texture_memory > 0)
+		{
+			statistics.num_textures += pair.layer->GetNumTextures();
+			statistics.texture_memory += texture_memory;
+		}
+	}
+}
+
 bool FontFaceHandleDefault::AppendGlyph(Character character)
 {
 	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs);
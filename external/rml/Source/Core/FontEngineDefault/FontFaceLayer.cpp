@@ -28,9 +28,17 @@
 
 #include "FontFaceLayer.h"
 #include "FontFaceHandleDefault.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include <algorithm>
+#include <string.h>
 
 namespace Rml {
 
+// Textures start small and grow as glyphs are added, up to the maximum dimensions.
+static constexpr int initial_texture_width = 512;
+static constexpr int initial_texture_height = 64;
+static constexpr int max_texture_dimensions = 1024;
+
 FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colour(255, 255, 255)
 {
 	effect = _effect;
@@ -43,26 +51,15 @@ FontFaceLayer::~FontFaceLayer()
 
 bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone, bool clone_glyph_origins)
 {
-	// Clear the old layout if it exists.
-	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
-		texture_layout = TextureLayout{};
-		character_boxes.clear();
-		textures.clear();
-	}
-
 	const FontGlyphMap& glyphs = handle->GetGlyphs();
 
 	// Generate the new layout.
 	if (clone)
 	{
-		// Clone the geometry and textures from the clone layer.
+		// Clone the geometry and textures from the clone layer, which has already been brought up to date.
 		character_boxes = clone->character_boxes;
-
-		// Copy the cloned layer's textures.
-		for (size_t i = 0; i < clone->textures.size(); ++i)
-			textures.push_back(clone->textures[i]);
+		textures = clone->textures;
+		pages.clear();
 
 		// Request the effect (if we have one) and adjust the origins as appropriate.
 		if (effect && !clone_glyph_origins)
@@ -97,136 +94,227 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 	}
 	else
 	{
-		// Initialise the texture layout for the glyphs.
-		character_boxes.reserve(glyphs.size());
+		// Find the glyphs added since the last generation, only those need to be rendered.
+		struct NewGlyph {
+			Character character;
+			const FontGlyph* glyph;
+			Vector2i dimensions;
+		};
+		Vector<NewGlyph> new_glyphs;
+
 		for (auto& pair : glyphs)
 		{
 			Character character = pair.first;
 			const FontGlyph& glyph = pair.second;
 
+			if (character_boxes.find(character) != character_boxes.end())
+				continue;
+
 			Vector2i glyph_origin(0, 0);
 			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
 
-			// Adjust glyph origin / dimensions for the font effect.
-			if (effect)
+			TextureBox box;
+
+			// Adjust glyph origin / dimensions for the font effect. Glyphs which the effect skips, or which have nothing
+			// to render such as spaces, are still recorded so that we do not consider them again.
+			if (!effect || effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
 			{
-				if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					continue;
-			}
+				box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+				box.dimensions = Vector2f(float(glyph_dimensions.x), float(glyph_dimensions.y));
 
-			TextureBox box;
-			box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
-			box.dimensions = Vector2f(float(glyph_dimensions.x), float(glyph_dimensions.y));
-			
-			RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
+				RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
 
-			character_boxes[character] = box;
+				if (glyph_dimensions.x > 0 && glyph_dimensions.y > 0)
+					new_glyphs.push_back(NewGlyph{ character, &glyph, glyph_dimensions });
+			}
 
-			// Add the character's dimensions into the texture layout engine.
-			texture_layout.AddRectangle((int)character, glyph_dimensions);
+			character_boxes[character] = box;
 		}
 
-		constexpr int max_texture_dimensions = 1024;
+		if (new_glyphs.empty())
+			return true;
 
-		// Generate the texture layout; this will position the glyph rectangles efficiently and
-		// allocate the texture data ready for writing.
-		if (!texture_layout.GenerateLayout(max_texture_dimensions))
-			return false;
+		// Place the tallest glyphs first, this packs the shelves more tightly.
+		std::sort(new_glyphs.begin(), new_glyphs.end(), [](const NewGlyph& lhs, const NewGlyph& rhs) {
+			return lhs.dimensions.y > rhs.dimensions.y || (lhs.dimensions.y == rhs.dimensions.y && lhs.dimensions.x > rhs.dimensions.x);
+		});
 
+		bool result = true;
 
-		// Iterate over each rectangle in the layout, copying the glyph data into the rectangle as
-		// appropriate and generating geometry.
-		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+		for (const NewGlyph& new_glyph : new_glyphs)
 		{
-			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
-			Character character = (Character)rectangle.GetId();
-			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-			TextureBox& box = character_boxes[character];
-
-			// Set the character's texture index.
-			box.texture_index = rectangle.GetTextureIndex();
-
-			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+			TextureBox& box = character_boxes[new_glyph.character];
+			if (!AllocateRectangle(new_glyph.dimensions, box.texture_index, box.position))
+			{
+				Log::Message(Log::LT_WARNING, "Font glyph of size %dx%d does not fit in a font texture.", new_glyph.dimensions.x, new_glyph.dimensions.y);
+				box.texture_index = -1;
+				result = false;
+			}
 		}
 
+		// Pages may have grown, so update the texture coordinates of every character in the changed pages.
+		for (auto& pair : character_boxes)
+		{
+			TextureBox& box = pair.second;
+			if (box.texture_index < 0 || !pages[box.texture_index].dirty)
+				continue;
+
+			const Vector2i texture_dimensions = pages[box.texture_index].dimensions;
+			box.texcoords[0].x = float(box.position.x) / float(texture_dimensions.x);
+			box.texcoords[0].y = float(box.position.y) / float(texture_dimensions.y);
+			box.texcoords[1].x = (float(box.position.x) + box.dimensions.x) / float(texture_dimensions.x);
+			box.texcoords[1].y = (float(box.position.y) + box.dimensions.y) / float(texture_dimensions.y);
+		}
+
+		// Render the new glyphs into their rectangles of the pages.
+		for (const NewGlyph& new_glyph : new_glyphs)
+		{
+			const TextureBox& box = character_boxes.find(new_glyph.character)->second;
+			if (box.texture_index >= 0)
+				RenderGlyph(box, *new_glyph.glyph);
+		}
+
+		// Replace the textures of the changed pages, the render interface will generate them again on first use.
 		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
 
-		// Generate the textures.
-		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+		for (int i = 0; i < (int)pages.size(); ++i)
 		{
+			if (!pages[i].dirty)
+				continue;
+
+			pages[i].dirty = false;
+
 			int texture_id = i;
 
-			TextureCallback texture_callback = [handle, effect_ptr, texture_id, handle_version](const String& /*name*/, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
-				bool result = handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version);
+			TextureCallback texture_callback = [handle, effect_ptr, texture_id](const String& /*name*/, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
+				bool result = handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id);
 				return result;
 			};
 
-			Texture texture;
-			texture.Set("font-face-layer", texture_callback);
-			textures.push_back(texture);
+			if (i >= (int)textures.size())
+				textures.resize(i + 1);
+
+			textures[i].Set("font-face-layer", texture_callback);
 		}
+
+		return result;
 	}
 
 	return true;
 }
 
-// Generates the texture data for a layer (for the texture database).
-bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
+bool FontFaceLayer::AllocateRectangle(const Vector2i dimensions, int& texture_index, Vector2i& position)
 {
-	if (texture_id < 0 ||
-		texture_id > texture_layout.GetNumTextures())
+	// Rectangles are spaced by a pixel from each other and the texture borders, to avoid filtering artifacts.
+	if (dimensions.x + 2 > max_texture_dimensions || dimensions.y + 2 > max_texture_dimensions)
 		return false;
 
-	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
-	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
-
-	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+	for (texture_index = 0; texture_index <= (int)pages.size(); ++texture_index)
 	{
-		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
+		if (texture_index == (int)pages.size())
+		{
+			AtlasPage page;
+			page.dimensions.x = initial_texture_width;
+			while (page.dimensions.x < dimensions.x + 2)
+				page.dimensions.x *= 2;
+			pages.push_back(std::move(page));
+		}
 
-		TextureBox& box = character_boxes[character];
+		AtlasPage& page = pages[texture_index];
 
-		if (box.texture_index != texture_id)
-			continue;
+		// Use the lowest shelf with room for the rectangle.
+		AtlasShelf* shelf = nullptr;
+		for (AtlasShelf& candidate : page.shelves)
+		{
+			if (candidate.height >= dimensions.y && candidate.cursor_x + dimensions.x + 1 <= page.dimensions.x && (!shelf || candidate.height < shelf->height))
+				shelf = &candidate;
+		}
 
-		auto it = glyphs.find((Character)rectangle.GetId());
-		if (it == glyphs.end())
-			continue;
+		if (!shelf)
+		{
+			// Open a new shelf below the others, growing the page as needed.
+			const int shelf_y = (page.shelves.empty() ? 1 : page.shelves.back().y + page.shelves.back().height + 1);
+			const int required_height = shelf_y + dimensions.y + 1;
+			if (required_height > max_texture_dimensions || dimensions.x + 2 > page.dimensions.x)
+				continue;
 
-		const FontGlyph& glyph = it->second;
+			int height = Math::Max(page.dimensions.y, initial_texture_height);
+			while (height < required_height)
+				height *= 2;
 
-		if (effect == nullptr)
-		{
-			// Copy the glyph's bitmap data into its allocated texture.
-			if (glyph.bitmap_data)
+			if (height != page.dimensions.y)
 			{
-				byte* destination = rectangle.GetTextureData();
-				const byte* source = glyph.bitmap_data;
+				const size_t old_size = page.data.size();
+				page.dimensions.y = height;
+				page.data.resize(size_t(page.dimensions.x * page.dimensions.y * 4));
 
-				for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+				// Set the new texture area to transparent white.
+				for (size_t i = old_size; i < page.data.size(); i += 4)
 				{
-					for (int k = 0; k < glyph.bitmap_dimensions.x; ++k)
-						destination[k * 4 + 3] = source[k];
-
-					destination += rectangle.GetTextureStride();
-					source += glyph.bitmap_dimensions.x;
+					page.data[i + 0] = 255;
+					page.data[i + 1] = 255;
+					page.data[i + 2] = 255;
+					page.data[i + 3] = 0;
 				}
 			}
+
+			page.shelves.push_back(AtlasShelf{ shelf_y, dimensions.y, 1 });
+			shelf = &page.shelves.back();
 		}
-		else
+
+		position = Vector2i(shelf->cursor_x, shelf->y);
+		shelf->cursor_x += dimensions.x + 1;
+		page.dirty = true;
+
+		return true;
+	}
+
+	return false;
+}
+
+void FontFaceLayer::RenderGlyph(const TextureBox& box, const FontGlyph& glyph)
+{
+	AtlasPage& page = pages[box.texture_index];
+	const int stride = page.dimensions.x * 4;
+	byte* destination = page.data.data() + box.position.y * stride + box.position.x * 4;
+
+	if (effect == nullptr)
+	{
+		// Copy the glyph's bitmap data into its allocated texture.
+		if (glyph.bitmap_data)
 		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y)), rectangle.GetTextureStride(), glyph);
+			const byte* source = glyph.bitmap_data;
+
+			for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			{
+				for (int k = 0; k < glyph.bitmap_dimensions.x; ++k)
+					destination[k * 4 + 3] = source[k];
+
+				destination += stride;
+				source += glyph.bitmap_dimensions.x;
+			}
 		}
 	}
+	else
+	{
+		effect->GenerateGlyphTexture(destination, Vector2i(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y)), stride, glyph);
+	}
+}
+
+// Generates the texture data for a layer (for the texture database).
+bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id) const
+{
+	if (texture_id < 0 ||
+		texture_id >= (int)pages.size())
+		return false;
+
+	const AtlasPage& page = pages[texture_id];
+
+	byte* data = new byte[page.data.size()];
+	memcpy(data, page.data.data(), page.data.size());
+
+	texture_data.reset(data);
+	texture_dimensions = page.dimensions;
 
 	return true;
 }
@@ -258,4 +346,17 @@ const Colourb& FontFaceLayer::GetColour() const
 	return colour;
 }
 
+int FontFaceLayer::GetNumCharacters() const
+{
+	return (int)character_boxes.size();
+}
+
+size_t FontFaceLayer::GetTextureMemory() const
+{
+	size_t result = 0;
+	for (const AtlasPage& page : pages)
+		result += page.data.size();
+	return result;
+}
+
 } // namespace Rml
@@ -33,7 +33,6 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/GeometryUtilities.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
-#include "../TextureLayout.h"
 
 namespace Rml {
 
@@ -53,10 +52,11 @@ public:
 	FontFaceLayer(const SharedPtr<const FontEffect>& _effect);
 	~FontFaceLayer();
 
-	/// Generates or re-generates the character and texture data for the layer.
+	/// Generates the character and texture data for the layer. When called again, only the glyphs added to the handle
+	/// since the last call are rendered, and they are inserted into the existing textures where they fit.
 	/// @param[in] handle The handle generating this layer.
-	/// @param[in] effect The effect to initialise the layer with.
 	/// @param[in] clone The layer to optionally clone geometry and texture data from.
+	/// @param[in] clone_glyph_origins True to keep the cloned glyph origins, false to let the effect adjust them.
 	/// @return True if the layer was generated successfully, false if not.
 	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
@@ -64,8 +64,7 @@ public:
 	/// @param[out] texture_data The pointer to be set to the generated texture data.
 	/// @param[out] texture_dimensions The dimensions of the texture.
 	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] glyphs The glyphs required by the font face handle.
-	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
+	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id) const;
 
 	/// Generates the geometry required to render a single character.
 	/// @param[out] geometry An array of geometries this layer will write to. It must be at least as big as the number of textures in this layer.
@@ -84,8 +83,8 @@ public:
 			return;
 
 		// Generate the geometry for the character.
-		Vector< Vertex >& character_vertices = geometry[box.texture_index].GetVertices();
-		Vector< int >& character_indices = geometry[box.texture_index].GetIndices();
+		MemoryVector< Vertex >& character_vertices = geometry[box.texture_index].GetVertices();
+		MemoryVector< int >& character_indices = geometry[box.texture_index].GetIndices();
 
 		character_vertices.resize(character_vertices.size() + 4);
 		character_indices.resize(character_indices.size() + 6);
@@ -112,6 +111,11 @@ public:
 	/// Returns the layer's colour.
 	const Colourb& GetColour() const;
 
+	/// Returns the number of characters in the layer.
+	int GetNumCharacters() const;
+	/// Returns the size, in bytes, of the texture data owned by this layer. Cloned layers share their textures and own none.
+	size_t GetTextureMemory() const;
+
 private:
 
 
@@ -125,17 +129,43 @@ private:
 		Vector2f dimensions;
 		// The texture coordinates for the character's geometry.
 		Vector2f texcoords[2];
+		// The position, in pixels, of the character's rectangle in its texture.
+		Vector2i position;
 
 		// The texture this character renders from.
 		int texture_index;
 	};
 
+	// A row of glyph rectangles in a texture, as tall as the glyph which opened it.
+	struct AtlasShelf
+	{
+		int y;
+		int height;
+		int cursor_x;
+	};
+
+	// The data of one of the layer's textures. It is kept around so that new glyphs can be added to it later.
+	struct AtlasPage
+	{
+		Vector2i dimensions;
+		Vector<byte> data;
+		Vector<AtlasShelf> shelves;
+		bool dirty = false;
+	};
+
+	/// Finds room for a rectangle of the given dimensions in one of the pages, adding or growing pages as needed.
+	/// @return False if the rectangle is too large to fit in any texture.
+	bool AllocateRectangle(Vector2i dimensions, int& texture_index, Vector2i& position);
+
+	/// Renders a glyph into its rectangle in the texture data.
+	void RenderGlyph(const TextureBox& box, const FontGlyph& glyph);
+
 	using CharacterMap = UnorderedMap<Character, TextureBox>;
 	using TextureList = Vector<Texture>;
 
 	SharedPtr<const FontEffect> effect;
 
-	TextureLayout texture_layout;
+	Vector<AtlasPage> pages;
 
 	CharacterMap character_boxes;
 	TextureList textures;
@@ -71,4 +71,10 @@ FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle s
 	return result;
 }
 
+void FontFamily::AddAtlasStatistics(FontAtlasStatistics& statistics) const
+{
+	for (const auto& face : font_faces)
+		face->AddAtlasStatistics(statistics);
+}
+
 } // namespace Rml
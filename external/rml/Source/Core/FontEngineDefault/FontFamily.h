@@ -61,6 +61,9 @@ public:
 	/// @return True if the face was loaded successfully, false otherwise.
 	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, bool release_stream);
 
+	/// Adds the glyph and texture usage of the family's faces to the statistics.
+	void AddAtlasStatistics(FontAtlasStatistics& statistics) const;
+
 protected:
 	String name;
 
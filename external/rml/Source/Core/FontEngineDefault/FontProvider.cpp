@@ -101,6 +101,12 @@ FontFaceHandleDefault* FontProvider::GetFallbackFontFace(int index, int font_siz
 	return nullptr;
 }
 
+void FontProvider::AddAtlasStatistics(FontAtlasStatistics& statistics)
+{
+	for (const auto& pair : FontProvider::Get().font_families)
+		pair.second->AddAtlasStatistics(statistics);
+}
+
 
 bool FontProvider::LoadFontFace(const String& file_name, bool fallback_face)
 {
@@ -72,6 +72,9 @@ public:
 	/// Return a font face handle with the given index, at the given font size.
 	static FontFaceHandleDefault* GetFallbackFontFace(int index, int font_size);
 
+	/// Adds the glyph and texture usage of all font face handles to the statistics.
+	static void AddAtlasStatistics(FontAtlasStatistics& statistics);
+
 private:
 	FontProvider();
 	~FontProvider();
@@ -37,6 +37,8 @@ namespace Rml {
 
 using FontFaceHandleFreetype = uintptr_t;
 
+struct FontAtlasStatistics;
+
 struct FontMetrics 
 {
 	int size;
@@ -39,7 +39,7 @@ static FT_Library ft_library = nullptr;
 
 
 static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs);
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs);
+static void BuildGlyphMap(int size, FontGlyphMap& glyphs);
 static void GenerateMetrics(FT_Face ft_face, FontMetrics& metrics);
 
 
@@ -135,7 +135,7 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 	}
 
 	// Construct the initial list of glyphs.
-	BuildGlyphMap(ft_face, font_size, glyphs);
+	BuildGlyphMap(font_size, glyphs);
 
 	// Generate the metrics for the handle.
 	GenerateMetrics(ft_face, metrics);
@@ -196,16 +196,11 @@ int FreeType::GetKerning(FontFaceHandleFreetype face, int font_size, Character l
 
 
 
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs)
+static void BuildGlyphMap(int size, FontGlyphMap& glyphs)
 {
 	glyphs.reserve(128);
 
-	// Add the ASCII characters now. Other characters are added later as needed.
-	FT_ULong code_min = 32;
-	FT_ULong code_max = 126;
-
-	for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
-		BuildGlyph(ft_face, (Character)character_code, glyphs);
+	// Characters are added as they are used, or prepared through FontEngineInterface::PrepareGlyphs().
 
 	// Add a replacement character for rendering unknown characters.
 	Character replacement_character = Character::Replacement;
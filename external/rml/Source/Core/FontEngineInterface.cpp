@@ -101,4 +101,13 @@ int FontEngineInterface::GetVersion(FontFaceHandle /*handle*/)
 	return 0;
 }
 
+void FontEngineInterface::PrepareGlyphs(FontFaceHandle /*handle*/, const String& /*characters*/)
+{
+}
+
+FontAtlasStatistics FontEngineInterface::GetAtlasStatistics()
+{
+	return FontAtlasStatistics();
+}
+
 } // namespace Rml
@@ -142,13 +142,13 @@ void Geometry::Render(Vector2f translation)
 }
 
 // Returns the geometry's vertices. If these are written to, Release() should be called to force a recompile.
-Vector< Vertex >& Geometry::GetVertices()
+MemoryVector< Vertex >& Geometry::GetVertices()
 {
 	return vertices;
 }
 
 // Returns the geometry's indices. If these are written to, Release() should be called to force a recompile.
-Vector< int >& Geometry::GetIndices()
+MemoryVector< int >& Geometry::GetIndices()
 {
 	return indices;
 }
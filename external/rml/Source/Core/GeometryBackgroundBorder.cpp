@@ -34,10 +34,10 @@
 
 namespace Rml {
 
-GeometryBackgroundBorder::GeometryBackgroundBorder(Vector<Vertex>& vertices, Vector<int>& indices) : vertices(vertices), indices(indices)
+GeometryBackgroundBorder::GeometryBackgroundBorder(MemoryVector<Vertex>& vertices, MemoryVector<int>& indices) : vertices(vertices), indices(indices)
 {}
 
-void GeometryBackgroundBorder::Draw(Vector<Vertex>& vertices, Vector<int>& indices, CornerSizes radii, const Box& box, const Vector2f offset, const Colourb background_color, const Colourb* border_colors)
+void GeometryBackgroundBorder::Draw(MemoryVector<Vertex>& vertices, MemoryVector<int>& indices, CornerSizes radii, const Box& box, const Vector2f offset, const Colourb background_color, const Colourb* border_colors)
 {
 	using Edge = Box::Edge;
 
@@ -29,6 +29,7 @@
 #ifndef RMLUI_CORE_GEOMETRYBACKGROUNDBORDER_H
 #define RMLUI_CORE_GEOMETRYBACKGROUNDBORDER_H
 
+#include "../../Include/RmlUi/Core/MemoryInterface.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/Vertex.h"
 
@@ -56,12 +57,12 @@ public:
 	/// @param[in] offset Offset the position of the generated vertices.
 	/// @param[in] background_color Color of the background, set alpha to zero to not generate a background.
 	/// @param[in] border_colors Pointer to a four-element array of border colors in top-right-bottom-left order, or nullptr to not generate borders.
-	static void Draw(Vector<Vertex>& vertices, Vector<int>& indices, CornerSizes radii, const Box& box, Vector2f offset, Colourb background_color, const Colourb* border_colors);
+	static void Draw(MemoryVector<Vertex>& vertices, MemoryVector<int>& indices, CornerSizes radii, const Box& box, Vector2f offset, Colourb background_color, const Colourb* border_colors);
 
 private:
 	enum Corner { TOP_LEFT, TOP_RIGHT, BOTTOM_RIGHT, BOTTOM_LEFT };
 
-	GeometryBackgroundBorder(Vector<Vertex>& vertices, Vector<int>& indices);
+	GeometryBackgroundBorder(MemoryVector<Vertex>& vertices, MemoryVector<int>& indices);
 
 	// -- Background --
 	// All draw operations place vertices in clockwise order.
@@ -108,8 +109,8 @@ private:
 	// -- Tools --
 	int GetNumPoints(float R) const;
 
-	Vector<Vertex>& vertices;
-	Vector<int>& indices;
+	MemoryVector<Vertex>& vertices;
+	MemoryVector<int>& indices;
 };
 
 } // namespace Rml
@@ -29,6 +29,7 @@
 #include "GeometryDatabase.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include <algorithm>
+#include <mutex>
 
 
 namespace Rml {
@@ -115,19 +116,24 @@ private:
 
 
 static Database geometry_database;
+// Geometry is created and destroyed while updating contexts, which may happen on multiple threads.
+static std::mutex geometry_database_mutex;
 
 GeometryDatabaseHandle Insert(Geometry* geometry)
 {
+	std::lock_guard<std::mutex> lock(geometry_database_mutex);
 	return geometry_database.insert(geometry);
 }
 
 void Erase(GeometryDatabaseHandle handle)
 {
+	std::lock_guard<std::mutex> lock(geometry_database_mutex);
 	geometry_database.erase(handle);
 }
 
 void ReleaseAll()
 {
+	std::lock_guard<std::mutex> lock(geometry_database_mutex);
 	geometry_database.for_each([](Geometry* geometry) {
 		geometry->Release();
 	});
@@ -80,8 +80,8 @@ void GeometryUtilities::GenerateQuad(Vertex* vertices, int* indices, Vector2f or
 // Generates the geometry required to render a line above, below or through a line of text.
 void GeometryUtilities::GenerateLine(FontFaceHandle font_face_handle, Geometry* geometry, Vector2f position, int width, Style::TextDecoration height, Colourb colour)
 {
-	Vector< Vertex >& line_vertices = geometry->GetVertices();
-	Vector< int >& line_indices = geometry->GetIndices();
+	MemoryVector< Vertex >& line_vertices = geometry->GetVertices();
+	MemoryVector< int >& line_indices = geometry->GetIndices();
 	float underline_thickness = 0;
 	float underline_position = GetFontEngineInterface()->GetUnderline(font_face_handle, underline_thickness);
 	int size = GetFontEngineInterface()->GetSize(font_face_handle);
@@ -110,8 +110,8 @@ void GeometryUtilities::GenerateLine(FontFaceHandle font_face_handle, Geometry*
 
 void GeometryUtilities::GenerateBackgroundBorder(Geometry* geometry, const Box& box, Vector2f offset, Vector4f border_radius, Colourb background_colour, const Colourb* border_colours)
 {
-	Vector<Vertex>& vertices = geometry->GetVertices();
-	Vector<int>& indices = geometry->GetIndices();
+	MemoryVector<Vertex>& vertices = geometry->GetVertices();
+	MemoryVector<int>& indices = geometry->GetIndices();
 
 	CornerSizes corner_sizes{ border_radius.x, border_radius.y, border_radius.z, border_radius.w };
 	GeometryBackgroundBorder::Draw(vertices, indices, corner_sizes, box, offset, background_colour, border_colours);
@@ -0,0 +1,212 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "HitTestGrid.h"
+#include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/ElementUtilities.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "TransformState.h"
+#include <cfloat>
+#include <cmath>
+
+namespace Rml {
+
+// Cells are large enough that most elements only overlap a few of them.
+static constexpr float cell_size = 64.f;
+
+void HitTestGrid::Build(Element* root, Vector2i dimensions)
+{
+	RMLUI_ZoneScoped;
+
+	entries.clear();
+	unbounded_entries.clear();
+	AddElement(root);
+
+	num_cells.x = Math::Max(1, Math::RoundUpToInteger(float(dimensions.x) / cell_size));
+	num_cells.y = Math::Max(1, Math::RoundUpToInteger(float(dimensions.y) / cell_size));
+
+	// Count the entries of each cell, then fill them in test order.
+	cell_offsets.assign(num_cells.x * num_cells.y + 1, 0);
+	for (const Entry& entry : entries)
+	{
+		if (!entry.bounded)
+			continue;
+
+		const Vector2i first = GetCell(entry.min);
+		const Vector2i last = GetCell(entry.max);
+		for (int y = first.y; y <= last.y; y++)
+			for (int x = first.x; x <= last.x; x++)
+				cell_offsets[y * num_cells.x + x + 1]++;
+	}
+
+	for (size_t i = 1; i < cell_offsets.size(); i++)
+		cell_offsets[i] += cell_offsets[i - 1];
+
+	cell_entries.resize(cell_offsets.back());
+	Vector<int> cell_fill(cell_offsets.begin(), cell_offsets.end() - 1);
+
+	for (int i = 0; i < (int)entries.size(); i++)
+	{
+		const Entry& entry = entries[i];
+		if (!entry.bounded)
+		{
+			unbounded_entries.push_back(i);
+			continue;
+		}
+
+		const Vector2i first = GetCell(entry.min);
+		const Vector2i last = GetCell(entry.max);
+		for (int y = first.y; y <= last.y; y++)
+			for (int x = first.x; x <= last.x; x++)
+				cell_entries[cell_fill[y * num_cells.x + x]++] = i;
+	}
+}
+
+void HitTestGrid::AddElement(Element* element)
+{
+	// Mirrors the traversal of Context::GetElementAtPoint(): the stacking context from the top down, then the element.
+	if (element->local_stacking_context)
+	{
+		if (element->stacking_context_dirty)
+			element->BuildLocalStackingContext();
+
+		for (int i = (int)element->stacking_context.size() - 1; i >= 0; --i)
+			AddElement(element->stacking_context[i]);
+	}
+
+	Entry entry;
+	entry.element = element;
+
+	const TransformState* transform_state = element->GetTransformState();
+	entry.bounded = !(transform_state && transform_state->GetTransform());
+
+	if (entry.bounded)
+	{
+		const Vector2f position = element->GetAbsoluteOffset(Box::BORDER);
+		entry.min = Vector2f(FLT_MAX);
+		entry.max = Vector2f(-FLT_MAX);
+
+		for (int i = 0; i < element->GetNumBoxes(); ++i)
+		{
+			Vector2f box_offset;
+			const Box& box = element->GetBox(i, box_offset);
+			const Vector2f box_position = position + box_offset;
+			const Vector2f box_dimensions = box.GetSize(Box::BORDER);
+
+			entry.min.x = Math::Min(entry.min.x, box_position.x);
+			entry.min.y = Math::Min(entry.min.y, box_position.y);
+			entry.max.x = Math::Max(entry.max.x, box_position.x + box_dimensions.x);
+			entry.max.y = Math::Max(entry.max.y, box_position.y + box_dimensions.y);
+		}
+	}
+
+	entries.push_back(entry);
+}
+
+Vector2i HitTestGrid::GetCell(Vector2f point) const
+{
+	// Clamping keeps the binning conservative: a point inside the bounds of an entry always maps to one of its cells.
+	const float x = Math::Clamp(std::floor(point.x / cell_size), 0.f, float(num_cells.x - 1));
+	const float y = Math::Clamp(std::floor(point.y / cell_size), 0.f, float(num_cells.y - 1));
+	return Vector2i(int(x), int(y));
+}
+
+int HitTestGrid::GetCellIndex(Vector2f point) const
+{
+	const Vector2i cell = GetCell(point);
+	return cell.y * num_cells.x + cell.x;
+}
+
+Element* HitTestGrid::GetElementAtPoint(Vector2f point, const ElementDocument* modal_document, const Element* ignore_element) const
+{
+	const int cell = GetCellIndex(point);
+	const int* it = cell_entries.data() + cell_offsets[cell];
+	const int* end = cell_entries.data() + cell_offsets[cell + 1];
+	const int* it_unbounded = unbounded_entries.data();
+	const int* end_unbounded = it_unbounded + unbounded_entries.size();
+
+	// Merge the cell with the unbounded entries, both are sorted in test order.
+	while (it != end || it_unbounded != end_unbounded)
+	{
+		int index;
+		if (it_unbounded == end_unbounded || (it != end && *it < *it_unbounded))
+			index = *it++;
+		else
+			index = *it_unbounded++;
+
+		const Entry& entry = entries[index];
+		if (entry.bounded && (point.x < entry.min.x || point.y < entry.min.y || point.x > entry.max.x || point.y > entry.max.y))
+			continue;
+
+		Element* element = entry.element;
+		if (modal_document && element->GetOwnerDocument() != modal_document)
+			continue;
+
+		if (ignore_element)
+		{
+			const Element* ancestor = element;
+			while (ancestor && ancestor != ignore_element)
+				ancestor = ancestor->GetParentNode();
+
+			if (ancestor)
+				continue;
+		}
+
+		if (IsPointWithinElement(element, point))
+			return element;
+	}
+
+	return nullptr;
+}
+
+bool HitTestGrid::IsPointWithinElement(Element* element, Vector2f point)
+{
+	// Ignore elements whose pointer events are disabled.
+	if (element->GetComputedValues().pointer_events == Style::PointerEvents::None)
+		return false;
+
+	// Projection may fail if we have a singular transformation matrix.
+	if (!element->Project(point) || !element->IsPointWithinElement(point))
+		return false;
+
+	Vector2i clip_origin, clip_dimensions;
+	if (ElementUtilities::GetClippingRegion(clip_origin, clip_dimensions, element))
+	{
+		return point.x >= clip_origin.x &&
+			point.y >= clip_origin.y &&
+			point.x <= (clip_origin.x + clip_dimensions.x) &&
+			point.y <= (clip_origin.y + clip_dimensions.y);
+	}
+
+	return true;
+}
+
+} // namespace Rml
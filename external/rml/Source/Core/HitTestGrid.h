@@ -0,0 +1,91 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_HITTESTGRID_H
+#define RMLUI_CORE_HITTESTGRID_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+class ElementDocument;
+
+/**
+	Spatial index used to find the element under a point.
+
+	Holds the elements of a context in the order Context::GetElementAtPoint() tests them, binned into a uniform grid by
+	the bounds of their border boxes. A query only tests the elements overlapping the grid cell of the point, in the same
+	order, so it returns the same element as walking the stacking contexts. Elements with a transform can not be bounded
+	and are tested for every point.
+ */
+
+class HitTestGrid : public NonCopyMoveable
+{
+public:
+	/// Rebuilds the grid from the element tree below the root.
+	/// @param[in] root The root element of the context.
+	/// @param[in] dimensions The dimensions of the context, points outside are binned into the border cells.
+	void Build(Element* root, Vector2i dimensions);
+
+	/// Returns the first element under the point, in the order of Context::GetElementAtPoint().
+	/// @param[in] point The point in context coordinates.
+	/// @param[in] modal_document If set, only elements of this document are considered.
+	/// @param[in] ignore_element If set, this element and its descendants are skipped.
+	Element* GetElementAtPoint(Vector2f point, const ElementDocument* modal_document, const Element* ignore_element) const;
+
+	/// Tests the element on its own, as done for each element by Context::GetElementAtPoint().
+	/// @return True if the element accepts pointer events and the point is within its border boxes and clipping region.
+	static bool IsPointWithinElement(Element* element, Vector2f point);
+
+private:
+	struct Entry {
+		Element* element;
+		Vector2f min, max;
+		bool bounded;
+	};
+
+	// Appends the element after everything in its local stacking context, recursively.
+	void AddElement(Element* element);
+	// Returns the index of the cell containing the point, clamped to the grid.
+	int GetCellIndex(Vector2f point) const;
+	Vector2i GetCell(Vector2f point) const;
+
+	Vector<Entry> entries;
+	// Entries without bounds, tested for every point.
+	Vector<int> unbounded_entries;
+	// The entries overlapping each cell, in test order, stored consecutively. The entries of cell i are found at
+	// [cell_offsets[i], cell_offsets[i + 1]) in cell_entries.
+	Vector<int> cell_offsets;
+	Vector<int> cell_entries;
+	Vector2i num_cells = Vector2i(1, 1);
+};
+
+} // namespace Rml
+#endif
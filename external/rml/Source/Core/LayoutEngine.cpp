@@ -51,9 +51,12 @@ static constexpr std::size_t ChunkSizeBig = sizeof(LayoutBlockBox);
 static constexpr std::size_t ChunkSizeMedium = MAX(sizeof(LayoutInlineBox), sizeof(LayoutInlineBoxText));
 static constexpr std::size_t ChunkSizeSmall = MAX(sizeof(LayoutLineBox), sizeof(LayoutBlockBoxSpace));
 
-static Pool< LayoutChunk<ChunkSizeBig> > layout_chunk_pool_big(50, true);
-static Pool< LayoutChunk<ChunkSizeMedium> > layout_chunk_pool_medium(50, true);
-static Pool< LayoutChunk<ChunkSizeSmall> > layout_chunk_pool_small(50, true);
+// Layout boxes never outlive a single formatting pass, so each thread formatting a context gets its own pools.
+static thread_local Pool< LayoutChunk<ChunkSizeBig> > layout_chunk_pool_big(50, true);
+static thread_local Pool< LayoutChunk<ChunkSizeMedium> > layout_chunk_pool_medium(50, true);
+static thread_local Pool< LayoutChunk<ChunkSizeSmall> > layout_chunk_pool_small(50, true);
+
+static thread_local int num_formatted_elements = 0;
 
 
 // Formats the contents for a root-level element (usually a document or floating element).
@@ -99,6 +102,24 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block, co
 	element->OnLayout();
 }
 
+bool LayoutEngine::IsLayoutBoundary(const Element* element)
+{
+	const ComputedValues& computed = element->GetComputedValues();
+
+	// Absolutely positioned and floating elements are formatted as roots of their own, see FormatElement() below. Percentage
+	// heights may resolve to auto depending on the containing block, so only heights given as lengths are definite.
+	const bool formatted_as_root = (computed.position == Style::Position::Absolute || computed.position == Style::Position::Fixed || computed.float_ != Style::Float::None);
+
+	return formatted_as_root && computed.display != Style::Display::None && computed.width.type != Style::Width::Auto && computed.height.type == Style::Height::Length;
+}
+
+int LayoutEngine::ResetNumFormattedElements()
+{
+	const int result = num_formatted_elements;
+	num_formatted_elements = 0;
+	return result;
+}
+
 void* LayoutEngine::AllocateLayoutChunk(size_t size)
 {
 	static_assert(ChunkSizeBig > ChunkSizeMedium && ChunkSizeMedium > ChunkSizeSmall, "The following assumes a strict ordering of the chunk sizes.");
@@ -139,6 +160,8 @@ bool LayoutEngine::FormatElement(LayoutBlockBox* block_context_box, Element* ele
 	RMLUI_ZoneName(name.c_str(), name.size());
 #endif
 
+	num_formatted_elements++;
+
 	auto& computed = element->GetComputedValues();
 
 	// Check if we have to do any special formatting for any elements that don't fit into the standard layout scheme.
@@ -55,6 +55,15 @@ public:
 	/// @param[in] element The element to lay out.
 	static bool FormatElement(LayoutBlockBox* block_context_box, Element* element);
 
+	/// Returns true if the element is formatted independently of its surroundings and its size doesn't depend on its
+	/// contents. Changes inside such an element can't affect the layout outside of it, so it can be formatted on its own.
+	/// @param[in] element The element to test.
+	static bool IsLayoutBoundary(const Element* element);
+
+	/// Resets the number of elements formatted on the calling thread.
+	/// @return The number of elements formatted since the last reset.
+	static int ResetNumFormattedElements();
+
 	static void* AllocateLayoutChunk(size_t size);
 	static void DeallocateLayoutChunk(void* chunk, size_t size);
 
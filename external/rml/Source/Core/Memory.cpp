@@ -88,7 +88,8 @@ void BasicStackAllocator::deallocate(void* obj) noexcept
 
 BasicStackAllocator& GetGlobalBasicStackAllocator()
 {
-	static BasicStackAllocator stack_allocator(10 * 1024);
+	// Per thread, allocations must be released in reverse order and contexts may be updated in parallel.
+	static thread_local BasicStackAllocator stack_allocator(10 * 1024);
 	return stack_allocator;
 }
 
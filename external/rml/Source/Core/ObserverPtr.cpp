@@ -28,6 +28,7 @@
 
 #include "../../Include/RmlUi/Core/ObserverPtr.h"
 #include "Pool.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -40,17 +41,26 @@ static Pool< ObserverPtrBlock >& GetPool()
 	return *pool;
 }
 
+static std::mutex& GetPoolMutex()
+{
+	// Leaked for the same reason as the pool above.
+	static std::mutex* mutex = new std::mutex;
+	return *mutex;
+}
+
 
 void DeallocateObserverPtrBlockIfEmpty(ObserverPtrBlock* block) {
 	RMLUI_ASSERT(block->num_observers >= 0);
 	if (block->num_observers == 0 && block->pointed_to_object == nullptr)
 	{
+		std::lock_guard<std::mutex> lock(GetPoolMutex());
 		GetPool().DestroyAndDeallocate(block);
 	}
 }
 
 ObserverPtrBlock* AllocateObserverPtrBlock()
 {
+	std::lock_guard<std::mutex> lock(GetPoolMutex());
 	return GetPool().AllocateAndConstruct();
 }
 
@@ -0,0 +1,73 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "Pool.h"
+#include <algorithm>
+#include <mutex>
+
+namespace Rml {
+
+// The registry and its mutex are intentionally leaked, pools of other threads and global pools may be destroyed after
+// the static variables of this file.
+static Vector<PoolBase*>& GetRegistry()
+{
+	static Vector<PoolBase*>* registry = new Vector<PoolBase*>;
+	return *registry;
+}
+
+static std::mutex& GetRegistryMutex()
+{
+	static std::mutex* mutex = new std::mutex;
+	return *mutex;
+}
+
+PoolBase::PoolBase()
+{
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+	GetRegistry().push_back(this);
+}
+
+PoolBase::~PoolBase()
+{
+}
+
+void PoolBase::Unregister()
+{
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+	Vector<PoolBase*>& registry = GetRegistry();
+	registry.erase(std::find(registry.begin(), registry.end(), this));
+}
+
+void PoolBase::ReleaseUnusedPools()
+{
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+	for (PoolBase* pool : GetRegistry())
+		pool->ReleaseUnused();
+}
+
+} // namespace Rml
@@ -31,13 +31,36 @@
 
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Debug.h"
+#include "../../Include/RmlUi/Core/MemoryInterface.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
 
 namespace Rml {
 
+/**
+	Keeps track of all pools, so that their chunks can be returned to the memory interface on shutdown, before the
+	interface is destroyed. The global pools themselves are only destroyed when the program exits.
+ */
+
+class PoolBase : public NonCopyMoveable
+{
+public:
+	/// Releases the chunks of all pools which have no objects allocated, including the pools of other threads. Must
+	/// not be called while other threads use their pools.
+	static void ReleaseUnusedPools();
+
+protected:
+	PoolBase();
+	virtual ~PoolBase();
+
+	/// Removes the pool from the registry, must be called by the destructor of the derived pool before it is destroyed.
+	void Unregister();
+	/// Releases all chunks of the pool if it has no objects allocated.
+	virtual void ReleaseUnused() = 0;
+};
+
 template < typename PoolType >
-class Pool
+class Pool : public PoolBase
 {
 private:
 	static constexpr size_t N = sizeof(PoolType);
@@ -54,8 +77,11 @@ private:
 	class PoolChunk : public NonCopyMoveable
 	{
 	public:
+		PoolChunk(const MemoryInterfaceAllocator<PoolNode>& allocator) : allocator(allocator) {}
 		PoolNode* chunk;
 		PoolChunk* next;
+		// The chunk and its nodes are returned to the memory interface they were allocated from.
+		MemoryInterfaceAllocator<PoolNode> allocator;
 	};
 
 public:
@@ -109,7 +135,8 @@ public:
 	Pool(int chunk_size = 0, bool grow = false);
 	~Pool();
 
-	/// Initialises the pool to a given size.
+	/// Initialises the pool to a given size. The first chunk is only allocated once the first object is, so that global
+	/// pools allocate through the memory interface installed before RmlUi is initialised.
 	void Initialise(int chunk_size, bool grow = false);
 
 	/// Returns the head of the linked list of allocated objects.
@@ -120,11 +147,16 @@ public:
 	/// no free objects being available, nullptr is returned.
 	template<typename... Args>
 	inline PoolType* AllocateAndConstruct(Args&&... args);
+	/// Attempts to allocate memory for an object from a free slot in the memory pool, without constructing it.
+	/// @return The memory for the object, or nullptr if no free objects are available.
+	inline void* Allocate();
 
 	/// Deallocates the object pointed to by the given iterator.
 	inline void DestroyAndDeallocate(Iterator& iterator);
 	/// Deallocates the given object.
 	inline void DestroyAndDeallocate(PoolType* object);
+	/// Deallocates the memory of an object which has already been destroyed.
+	inline void Deallocate(PoolType* object);
 
 	/// Returns the number of objects in the pool.
 	inline int GetSize() const;
@@ -133,9 +165,16 @@ public:
 	/// Returns the number of allocated objects in the pool.
 	inline int GetNumAllocatedObjects() const;
 
+protected:
+	void ReleaseUnused() override;
+
 private:
 	// Creates a new pool chunk and appends its nodes to the beginning of the free list.
 	void CreateChunk();
+	// Returns all chunks to their memory interface and empties the pool.
+	void ReleaseChunks();
+	// Moves the node from the list of allocated objects to the free list.
+	inline void DeallocateNode(PoolNode* node);
 
 	int chunk_size;
 	bool grow;
@@ -51,16 +51,8 @@ Pool< PoolType >::~Pool()
 {
 	RMLUI_ASSERT(num_allocated_objects == 0);
 
-	PoolChunk* chunk = pool;
-	while (chunk)
-	{
-		PoolChunk* next_chunk = chunk->next;
-
-		delete[] chunk->chunk;
-		delete chunk;
-
-		chunk = next_chunk;
-	}
+	Unregister();
+	ReleaseChunks();
 }
 
 // Initialises the pool to a given size.
@@ -77,9 +69,6 @@ void Pool< PoolType >::Initialise(int _chunk_size, bool _grow)
 	grow = _grow;
 	chunk_size = _chunk_size;
 	pool = nullptr;
-
-	// Create the initial chunk.
-	CreateChunk();
 }
 
 // Returns the head of the linked list of allocated objects.
@@ -93,12 +82,23 @@ typename Pool< PoolType >::Iterator Pool< PoolType >::Begin()
 template<typename PoolType>
 template<typename ...Args>
 inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
+{
+	void* memory = Allocate();
+	if (memory == nullptr)
+		return nullptr;
+
+	return new (memory) PoolType(std::forward<Args>(args)...);
+}
+
+// Attempts to allocate memory for an object in the memory pool.
+template<typename PoolType>
+inline void* Pool<PoolType>::Allocate()
 {
 	// We can't allocate a new object if the deallocated list is empty.
 	if (first_free_node == nullptr)
 	{
-		// Attempt to grow the pool first.
-		if (grow)
+		// Attempt to grow the pool first, the initial chunk is always created on first use.
+		if (grow || pool == nullptr)
 		{
 			CreateChunk();
 			if (first_free_node == nullptr)
@@ -140,19 +140,46 @@ inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 
 	first_allocated_node = allocated_object;
 
-	return new (allocated_object->object) PoolType(std::forward<Args>(args)...);
+	return allocated_object->object;
 }
 
 // Deallocates the object pointed to by the given iterator.
 template < typename PoolType >
 void Pool< PoolType >::DestroyAndDeallocate(Iterator& iterator)
 {
-	// We're about to deallocate an object.
-	--num_allocated_objects;
-
 	PoolNode* object = iterator.node;
 	reinterpret_cast<PoolType*>(object->object)->~PoolType();
 
+	// Increment the iterator, so it points to the next active object.
+	iterator.node = object->next;
+
+	DeallocateNode(object);
+}
+
+// Deallocates the given object.
+template < typename PoolType >
+void Pool< PoolType >::DestroyAndDeallocate(PoolType* object)
+{
+	// This assumes the object has the same address as the node, which will be
+	// true as long as the struct definition does not change.
+	Iterator iterator((PoolNode*) object);
+	DestroyAndDeallocate(iterator);
+}
+
+// Deallocates the memory of an object which has already been destroyed.
+template < typename PoolType >
+void Pool< PoolType >::Deallocate(PoolType* object)
+{
+	DeallocateNode((PoolNode*) object);
+}
+
+// Moves the node from the list of allocated objects to the free list.
+template < typename PoolType >
+void Pool< PoolType >::DeallocateNode(PoolNode* object)
+{
+	// We're about to deallocate an object.
+	--num_allocated_objects;
+
 	// Get the previous and next pointers now, because they will be overwritten
 	// before we're finished.
 	PoolNode* previous_object = object->previous;
@@ -182,19 +209,6 @@ void Pool< PoolType >::DestroyAndDeallocate(Iterator& iterator)
 	}
 
 	first_free_node = object;
-
-	// Increment the iterator, so it points to the next active object.
-	iterator.node = next_object;
-}
-
-// Deallocates the given object.
-template < typename PoolType >
-void Pool< PoolType >::DestroyAndDeallocate(PoolType* object)
-{
-	// This assumes the object has the same address as the node, which will be
-	// true as long as the struct definition does not change.
-	Iterator iterator((PoolNode*) object);
-	DestroyAndDeallocate(iterator);
 }
 
 // Returns the number of objects in the pool.
@@ -235,16 +249,19 @@ void Pool< PoolType >::CreateChunk()
 		return;
 
 	// Create the new chunk and mark it as the first chunk.
-	PoolChunk* new_chunk = new PoolChunk();
+	MemoryInterfaceAllocator<PoolChunk> chunk_allocator;
+	PoolChunk* new_chunk = new (chunk_allocator.allocate(1)) PoolChunk(chunk_allocator);
 	new_chunk->next = pool;
 	pool = new_chunk;
 
 	// Create chunk's pool nodes.
-	new_chunk->chunk = new PoolNode[chunk_size];
+	new_chunk->chunk = new_chunk->allocator.allocate(chunk_size);
 
 	// Initialise the linked list.
 	for (int i = 0; i < chunk_size; i++)
 	{
+		new (&new_chunk->chunk[i]) PoolNode;
+
 		if (i == 0)
 			new_chunk->chunk[i].previous = nullptr ;
 		else
@@ -259,4 +276,34 @@ void Pool< PoolType >::CreateChunk()
 	first_free_node = new_chunk->chunk;
 }
 
+// Returns all chunks to their memory interface and empties the pool.
+template < typename PoolType >
+void Pool< PoolType >::ReleaseChunks()
+{
+	PoolChunk* chunk = pool;
+	while (chunk)
+	{
+		PoolChunk* next_chunk = chunk->next;
+
+		MemoryInterfaceAllocator<PoolChunk> chunk_allocator(chunk->allocator);
+		chunk->allocator.deallocate(chunk->chunk, chunk_size);
+		chunk->~PoolChunk();
+		chunk_allocator.deallocate(chunk, 1);
+
+		chunk = next_chunk;
+	}
+
+	pool = nullptr;
+	first_allocated_node = nullptr;
+	first_free_node = nullptr;
+}
+
+// Releases all chunks of the pool if it has no objects allocated.
+template < typename PoolType >
+void Pool< PoolType >::ReleaseUnused()
+{
+	if (num_allocated_objects == 0)
+		ReleaseChunks();
+}
+
 } // namespace Rml
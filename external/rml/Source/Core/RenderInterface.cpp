@@ -79,6 +79,17 @@ void RenderInterface::SetTransform(const Matrix4f* /*transform*/)
 {
 }
 
+// Called by RmlUi when it wants to multiply the alpha of following geometry.
+void RenderInterface::SetOpacity(float /*opacity*/)
+{
+}
+
+// Called by RmlUi to determine whether the renderer applies transform and opacity to all following geometry.
+bool RenderInterface::SupportsCompositing()
+{
+	return false;
+}
+
 // Get the context currently being rendered.
 Context* RenderInterface::GetContext() const
 {
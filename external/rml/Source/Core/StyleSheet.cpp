@@ -28,6 +28,7 @@
 
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "ElementDefinition.h"
+#include "ElementStyle.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
@@ -41,9 +42,13 @@
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/FontEffectInstancer.h"
 #include <algorithm>
+#include <mutex>
 
 namespace Rml {
 
+// Guards the element definition caches of all style sheets.
+static std::mutex node_cache_mutex;
+
 // Sorts style nodes based on specificity.
 inline static bool StyleSheetNodeSort(const StyleSheetNode* lhs, const StyleSheetNode* rhs)
 {
@@ -63,6 +68,7 @@ StyleSheet::~StyleSheet()
 bool StyleSheet::LoadStyleSheet(Stream* stream, int begin_line_number)
 {
 	StyleSheetParser parser;
+	node_index_built = false;
 	specificity_offset = parser.Parse(root.get(), stream, *this, keyframes, decorator_map, spritesheet_list, begin_line_number);
 	return specificity_offset >= 0;
 }
@@ -107,10 +113,15 @@ SharedPtr<StyleSheet> StyleSheet::CombineStyleSheet(const StyleSheet& other_shee
 // Builds the node index for a combined style sheet.
 void StyleSheet::BuildNodeIndex()
 {
+	// Style sheets are shared between documents, the nodes don't change after the sheet has been combined.
+	if (node_index_built)
+		return;
+
 	RMLUI_ZoneScoped;
-	styled_node_index.clear();
+	styled_node_index = NodeIndex();
 	root->BuildIndex(styled_node_index);
 	root->SetStructurallyVolatileRecursive(false);
+	node_index_built = true;
 }
 
 // Builds the node index for a combined style sheet.
@@ -320,14 +331,22 @@ FontEffectsPtr StyleSheet::InstanceFontEffectsFromString(const String& font_effe
 	return MakeShared<FontEffects>(std::move(font_effects));
 }
 
-size_t StyleSheet::NodeHash(const String& tag, const String& id)
+StyleSheet::SelectorDependency StyleSheet::GetClassDependency(const String& class_name) const
 {
-	size_t seed = 0;
-	if (!tag.empty())
-		seed = Hash<String>()(tag);
-	if(!id.empty())
-		Utilities::HashCombine(seed, id);
-	return seed;
+	if (styled_node_index.ancestor_class_dependencies.count(class_name))
+		return SelectorDependency::SelfAndDescendants;
+	if (styled_node_index.class_dependencies.count(class_name))
+		return SelectorDependency::Self;
+	return SelectorDependency::None;
+}
+
+StyleSheet::SelectorDependency StyleSheet::GetPseudoClassDependency(const String& pseudo_class) const
+{
+	if (styled_node_index.ancestor_pseudo_class_dependencies.count(pseudo_class))
+		return SelectorDependency::SelfAndDescendants;
+	if (styled_node_index.pseudo_class_dependencies.count(pseudo_class))
+		return SelectorDependency::Self;
+	return SelectorDependency::None;
 }
 
 // Returns the compiled element definition for a given element hierarchy.
@@ -337,48 +356,36 @@ SharedPtr<ElementDefinition> StyleSheet::GetElementDefinition(const Element* ele
 
 	// See if there are any styles defined for this element.
 	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static Vector< const StyleSheetNode* > applicable_nodes;
+	static thread_local Vector< const StyleSheetNode* > applicable_nodes;
 	applicable_nodes.clear();
 
-	const String& tag = element->GetTagName();
-	const String& id = element->GetId();
-
-	// The styled_node_index is hashed with the tag and id of the RCSS rule. However, we must also check
-	// the rules which don't have them defined, because they apply regardless of tag and id.
-	Array<size_t, 4> node_hash;
-	int num_hashes = 2;
-
-	node_hash[0] = 0;
-	node_hash[1] = NodeHash(tag, String());
+	// Every styled node is indexed by exactly one of its id, first class, or tag. Thus, we only need to consider the
+	// nodes indexed by one of the element's own names, and the nodes without any of them.
+	auto add_applicable_nodes = [element](const NodeList& nodes) {
+		// Now see if we satisfy all of the requirements: tag, id, classes, pseudo classes, structural selectors, and
+		// the full requirements of parent nodes. What this involves is traversing the style nodes backwards, trying to
+		// match nodes in the element's hierarchy to nodes in the style hierarchy.
+		for (StyleSheetNode* node : nodes)
+		{
+			if (node->IsApplicable(element, false))
+				applicable_nodes.push_back(node);
+		}
+	};
+	auto add_indexed_nodes = [&](const UnorderedMap< String, NodeList >& index, const String& name) {
+		auto it_nodes = index.find(name);
+		if (it_nodes != index.end())
+			add_applicable_nodes(it_nodes->second);
+	};
 
-	// If we don't have an id, we can safely skip nodes that define an id. Otherwise, we also check the id nodes.
+	const String& id = element->GetId();
 	if (!id.empty())
-	{
-		num_hashes = 4;
-		node_hash[2] = NodeHash(String(), id);
-		node_hash[3] = NodeHash(tag, id);
-	}
+		add_indexed_nodes(styled_node_index.ids, id);
 
-	// The hashes are keys into a set of applicable nodes (given tag and id).
-	for (int i = 0; i < num_hashes; i++)
-	{
-		auto it_nodes = styled_node_index.find(node_hash[i]);
-		if (it_nodes != styled_node_index.end())
-		{
-			const NodeList& nodes = it_nodes->second;
+	for (const String& class_name : element->GetStyle()->GetClassNameList())
+		add_indexed_nodes(styled_node_index.classes, class_name);
 
-			// Now see if we satisfy all of the requirements not yet tested: classes, pseudo classes, structural selectors, 
-			// and the full requirements of parent nodes. What this involves is traversing the style nodes backwards, 
-			// trying to match nodes in the element's hierarchy to nodes in the style hierarchy.
-			for (StyleSheetNode* node : nodes)
-			{
-				if (node->IsApplicable(element, true))
-				{
-					applicable_nodes.push_back(node);
-				}
-			}
-		}
-	}
+	add_indexed_nodes(styled_node_index.tags, element->GetTagName());
+	add_applicable_nodes(styled_node_index.other);
 
 	std::sort(applicable_nodes.begin(), applicable_nodes.end(), StyleSheetNodeSort);
 
@@ -391,6 +398,9 @@ SharedPtr<ElementDefinition> StyleSheet::GetElementDefinition(const Element* ele
 	for (const StyleSheetNode* node : applicable_nodes)
 		Utilities::HashCombine(seed, node);
 
+	// Style sheets are shared between documents, which may be updated from different threads.
+	std::lock_guard<std::mutex> lock(node_cache_mutex);
+
 	auto cache_iterator = node_cache.find(seed);
 	if (cache_iterator != node_cache.end())
 	{
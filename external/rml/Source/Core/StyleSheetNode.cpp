@@ -126,12 +126,31 @@ void StyleSheetNode::BuildIndex(StyleSheet::NodeIndex& styled_node_index)
 	// If this has properties defined, then we insert it into the styled node index.
 	if(properties.GetNumProperties() > 0)
 	{
-		// The keys of the node index is a hashed combination of tag and id. These are used for fast lookup of applicable nodes.
-		size_t node_hash = StyleSheet::NodeHash(tag, id);
-		StyleSheet::NodeList& nodes = styled_node_index[node_hash];
-		auto it = std::find(nodes.begin(), nodes.end(), this);
-		if(it == nodes.end())
-			nodes.push_back(this);
+		// Each node is indexed by its most selective requirement only: the id, otherwise the first class, otherwise the tag.
+		// An element can then only be matched by nodes indexed by one of its own names, or by nodes without any of them.
+		StyleSheet::NodeList* nodes = &styled_node_index.other;
+		if (!id.empty())
+			nodes = &styled_node_index.ids[id];
+		else if (!class_names.empty())
+			nodes = &styled_node_index.classes[class_names[0]];
+		else if (!tag.empty())
+			nodes = &styled_node_index.tags[tag];
+
+		auto it = std::find(nodes->begin(), nodes->end(), this);
+		if(it == nodes->end())
+			nodes->push_back(this);
+
+		// Record which classes and pseudo classes the styled nodes depend on, so that changing any other class on an
+		// element doesn't require its definition to be looked up again. Classes on the ancestor nodes additionally
+		// affect the definitions of the element's descendants.
+		styled_node_index.class_dependencies.insert(class_names.begin(), class_names.end());
+		styled_node_index.pseudo_class_dependencies.insert(pseudo_class_names.begin(), pseudo_class_names.end());
+
+		for (const StyleSheetNode* node = parent; node && node->parent; node = node->parent)
+		{
+			styled_node_index.ancestor_class_dependencies.insert(node->class_names.begin(), node->class_names.end());
+			styled_node_index.ancestor_pseudo_class_dependencies.insert(node->pseudo_class_names.begin(), node->pseudo_class_names.end());
+		}
 	}
 
 	for (auto& child : children)
@@ -301,8 +320,12 @@ bool StyleSheetNode::IsApplicable(const Element* const in_element, bool skip_id_
 	}
 	else
 	{
-		// Id and tag have not already been matched, match everything.
-		if (!Match(in_element))
+		// Id and tag have not already been matched, match everything except for the structural selectors.
+		if (!tag.empty() && tag != in_element->GetTagName())
+			return false;
+		if (!id.empty() && id != in_element->GetId())
+			return false;
+		if (!MatchClassPseudoClass(in_element))
 			return false;
 	}
 
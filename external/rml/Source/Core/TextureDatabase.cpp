@@ -31,9 +31,14 @@
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/StringUtilities.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include <mutex>
 
 namespace Rml {
 
+// Textures are fetched while updating contexts, which may happen on multiple threads. Recursive, as releasing a
+// texture may remove it from the callback textures.
+static std::recursive_mutex texture_database_mutex;
+
 static TextureDatabase* texture_database = nullptr;
 
 TextureDatabase::TextureDatabase()
@@ -86,6 +91,8 @@ SharedPtr<TextureResource> TextureDatabase::Fetch(const String& source, const St
 	else
 		GetSystemInterface()->JoinPath(path, StringUtilities::Replace(source_directory, '|', ':'), source);
 
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
+
 	TextureMap::iterator iterator = texture_database->textures.find(path);
 	if (iterator != texture_database->textures.end())
 	{
@@ -101,12 +108,14 @@ SharedPtr<TextureResource> TextureDatabase::Fetch(const String& source, const St
 
 void TextureDatabase::AddCallbackTexture(TextureResource* texture)
 {
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
 	if (texture_database)
 		texture_database->callback_textures.insert(texture);
 }
 
 void TextureDatabase::RemoveCallbackTexture(TextureResource* texture)
 {
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
 	if (texture_database)
 		texture_database->callback_textures.erase(texture);
 }
@@ -114,7 +123,8 @@ void TextureDatabase::RemoveCallbackTexture(TextureResource* texture)
 StringList TextureDatabase::GetSourceList()
 {
 	StringList result;
-	
+
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
 	if (texture_database)
 	{
 		result.reserve(texture_database->textures.size());
@@ -128,6 +138,7 @@ StringList TextureDatabase::GetSourceList()
 
 void TextureDatabase::ReleaseTextures(RenderInterface* render_interface)
 {
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
 	if (texture_database)
 	{
 		for (const auto& texture : texture_database->textures)
@@ -138,4 +149,18 @@ void TextureDatabase::ReleaseTextures(RenderInterface* render_interface)
 	}
 }
 
+bool TextureDatabase::ReleaseTexture(const String& source)
+{
+	std::lock_guard<std::recursive_mutex> lock(texture_database_mutex);
+	if (!texture_database)
+		return false;
+
+	auto iterator = texture_database->textures.find(source);
+	if (iterator == texture_database->textures.end())
+		return false;
+
+	iterator->second->Release();
+	return true;
+}
+
 } // namespace Rml
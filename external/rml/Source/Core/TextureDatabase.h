@@ -55,6 +55,10 @@ public:
     /// Pass nullptr to release all textures in the database.
 	static void ReleaseTextures(RenderInterface* render_interface = nullptr);
 
+	/// Release a single texture from all render interfaces, it will be loaded again the next time it is used.
+	/// @return True if the texture was found in the database.
+	static bool ReleaseTexture(const String& source);
+
     /// Adds a texture resource with a callback function and stores it as a weak (raw) pointer in the database.
     static void AddCallbackTexture(TextureResource* texture);
 
@@ -31,9 +31,17 @@
 #include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include <atomic>
+#include <mutex>
 
 namespace Rml {
 
+// Resources are shared between contexts, and images request their dimensions during layout.
+static std::mutex texture_resource_mutex;
+
+// Font face layers replace their textures while contexts are updated from multiple threads.
+static std::atomic<int> texture_release_version{0};
+
 TextureResource::TextureResource()
 {
 }
@@ -73,6 +81,7 @@ void TextureResource::Reset()
 // Returns the resource's underlying texture.
 TextureHandle TextureResource::GetHandle(RenderInterface* render_interface)
 {
+	std::lock_guard<std::mutex> lock(texture_resource_mutex);
 	auto texture_iterator = texture_data.find(render_interface);
 	if (texture_iterator == texture_data.end())
 	{
@@ -86,6 +95,7 @@ TextureHandle TextureResource::GetHandle(RenderInterface* render_interface)
 // Returns the dimensions of the resource's texture.
 const Vector2i& TextureResource::GetDimensions(RenderInterface* render_interface)
 {
+	std::lock_guard<std::mutex> lock(texture_resource_mutex);
 	auto texture_iterator = texture_data.find(render_interface);
 	if (texture_iterator == texture_data.end())
 	{
@@ -105,13 +115,17 @@ const String& TextureResource::GetSource() const
 // Releases the texture's handle.
 void TextureResource::Release(RenderInterface* render_interface)
 {
+	std::lock_guard<std::mutex> lock(texture_resource_mutex);
 	if (!render_interface)
 	{
 		for (auto& interface_data_pair : texture_data)
 		{
 			TextureHandle handle = interface_data_pair.second.first;
 			if (handle)
+			{
 				interface_data_pair.first->ReleaseTexture(handle);
+				++texture_release_version;
+			}
 		}
 
 		texture_data.clear();
@@ -124,12 +138,20 @@ void TextureResource::Release(RenderInterface* render_interface)
 
 		TextureHandle handle = texture_iterator->second.first;
 		if (handle)
+		{
 			texture_iterator->first->ReleaseTexture(handle);
+			++texture_release_version;
+		}
 
 		texture_data.erase(render_interface);
 	}
 }
 
+int TextureResource::GetReleaseVersion()
+{
+	return texture_release_version;
+}
+
 bool TextureResource::Load(RenderInterface* render_interface)
 {
 	RMLUI_ZoneScoped;
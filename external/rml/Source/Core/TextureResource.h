@@ -66,6 +66,10 @@ public:
 	/// Releases the texture's handle.
 	void Release(RenderInterface* render_interface = nullptr);
 
+	/// Returns a counter which is incremented whenever any texture handle is released, so that recorded render calls
+	/// which may reference the handle are not reused.
+	static int GetReleaseVersion();
+
 private:
 	void Reset();
 
@@ -10,7 +10,7 @@ project "rml"
 	}
 	links { "engine", "renderer" }
 	includedirs { "external/rml/Include", "../../external/freetype/include" }
-	defines { "RMLUI_STATIC_LIB=1", "RMLUI_USE_CUSTOM_RTTI" }
+	defines { "RMLUI_STATIC_LIB=1", "RMLUI_USE_CUSTOM_RTTI", "RMLUI_CUSTOM_PROFILING" }
 	defaultConfigurations()
 	useLua()
 
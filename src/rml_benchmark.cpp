@@ -0,0 +1,729 @@
+#define LUMIX_NO_CUSTOM_CRT
+#include "rml_benchmark.h"
+#include "RmlUi/Core.h"
+#include "engine/array.h"
+#include "engine/job_system.h"
+#include "engine/log.h"
+#include "engine/math.h"
+#include "engine/os.h"
+#include "engine/stream.h"
+#include "engine/sync.h"
+#include <stdlib.h>
+
+namespace Lumix {
+
+// counts what rml asks to draw instead of drawing it, so the benchmark does not need GPU
+struct CountingRenderInterface : Rml::RenderInterface {
+	struct Stats {
+		u64 draws = 0;
+		u64 vertices = 0;
+		u64 indices = 0;
+		u64 bytes_uploaded = 0; // vertices and indices of immediate and compiled geometries, pixels of generated textures
+	};
+
+	struct CompiledGeometry {
+		u32 num_vertices = 0;
+		u32 num_indices = 0;
+		i32 next_free = -1;
+	};
+
+	CountingRenderInterface(IAllocator& allocator) : m_compiled_geometries(allocator) {}
+
+	void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override {
+		++m_stats.draws;
+		m_stats.vertices += num_vertices;
+		m_stats.indices += num_indices;
+		m_stats.bytes_uploaded += num_vertices * sizeof(Rml::Vertex) + num_indices * sizeof(int);
+	}
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) override {
+		MutexGuard guard(m_mutex);
+		i32 idx = m_first_free_geometry;
+		if (idx >= 0) {
+			m_first_free_geometry = m_compiled_geometries[idx].next_free;
+		}
+		else {
+			idx = m_compiled_geometries.size();
+			m_compiled_geometries.emplace();
+		}
+		CompiledGeometry& geometry = m_compiled_geometries[idx];
+		geometry.num_vertices = num_vertices;
+		geometry.num_indices = num_indices;
+		geometry.next_free = -1;
+		++m_num_compiled_geometries;
+		m_stats.bytes_uploaded += num_vertices * sizeof(Rml::Vertex) + num_indices * sizeof(int);
+		return Rml::CompiledGeometryHandle(idx + 1);
+	}
+
+	void RenderCompiledGeometry(Rml::CompiledGeometryHandle handle, const Rml::Vector2f& translation) override {
+		const CompiledGeometry& geometry = m_compiled_geometries[i32(handle) - 1];
+		++m_stats.draws;
+		m_stats.vertices += geometry.num_vertices;
+		m_stats.indices += geometry.num_indices;
+	}
+
+	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle handle) override {
+		MutexGuard guard(m_mutex);
+		const i32 idx = i32(handle) - 1;
+		m_compiled_geometries[idx].next_free = m_first_free_geometry;
+		m_first_free_geometry = idx;
+		--m_num_compiled_geometries;
+	}
+
+	void EnableScissorRegion(bool enable) override {}
+	void SetScissorRegion(int x, int y, int width, int height) override {}
+	void SetOpacity(float opacity) override {}
+	// same as the engine's render interface, so animations take the same path
+	bool SupportsCompositing() override { return false; }
+
+	// image files are not decoded, images without explicit size are laid out as 1x1
+	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override {
+		MutexGuard guard(m_mutex);
+		texture_handle = ++m_last_texture;
+		texture_dimensions = Rml::Vector2i(1, 1);
+		return true;
+	}
+
+	bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions) override {
+		MutexGuard guard(m_mutex);
+		texture_handle = ++m_last_texture;
+		m_stats.bytes_uploaded += u64(source_dimensions.x) * source_dimensions.y * 4;
+		return true;
+	}
+
+	void ReleaseTexture(Rml::TextureHandle texture) override {}
+
+	Array<CompiledGeometry> m_compiled_geometries;
+	i32 m_first_free_geometry = -1;
+	u32 m_num_compiled_geometries = 0;
+	Rml::TextureHandle m_last_texture = 0;
+	Stats m_stats;
+	// scaling benchmark updates contexts from jobs, rml releases geometry and loads textures while updating
+	Mutex m_mutex;
+};
+
+// sums of all frames and contexts of one document
+struct BenchmarkResult {
+	float load_time = 0; // loading the documents and their first update and render
+	float update_time = 0;
+	double style_time = 0;
+	double layout_time = 0;
+	float render_time = 0;
+	float max_frame_time = 0; // update and render of all contexts in the slowest frame
+	u64 layout_roots = 0;
+	u64 layout_elements = 0;
+	CountingRenderInterface::Stats render_stats;
+	u32 compiled_geometries = 0; // alive at the end of the run
+	u64 element_arena_bytes = 0; // allocated from element arenas at the end of the run
+	u64 element_arena_allocations = 0;
+};
+
+// corpus lines starting with `<mode>:` run something else than the default per-frame sweep, see rml_benchmark.h
+enum class BenchmarkMode : u32 {
+	FRAMES,
+	LOAD,
+	SCALING,
+	EXPRESSIONS,
+	LIST,
+	RESTYLE,
+	HIT_TEST
+};
+
+static const char* const MODE_NAMES[] = { "frames", "load", "scaling", "expressions", "list", "restyle", "hit_test" };
+
+// removes `<mode>:` from the start of the line
+static BenchmarkMode parseMode(Rml::String& line) {
+	const size_t colon = line.find(':');
+	if (colon == Rml::String::npos) return BenchmarkMode::FRAMES;
+	for (u32 i = 0; i < lengthOf(MODE_NAMES); ++i) {
+		if (line.compare(0, colon, MODE_NAMES[i]) != 0) continue;
+		const size_t args = line.find_first_not_of(" \t", colon + 1);
+		line = args == Rml::String::npos ? Rml::String() : line.substr(args);
+		return BenchmarkMode(i);
+	}
+	return BenchmarkMode::FRAMES;
+}
+
+static void writeJSONString(Rml::String& json, const Rml::String& value) {
+	json += '"';
+	for (char c : value) {
+		if (c == '"' || c == '\\') json += '\\';
+		json += c;
+	}
+	json += '"';
+}
+
+static void writeResult(Rml::String& json, const BenchmarkResult& r, u32 num_contexts, u32 frames) {
+	// times are in milliseconds, everything except load and memory is averaged per frame
+	const double ms = 1000.0 / frames;
+	json += Rml::CreateString(1024,
+		",\n\t\t\t\"contexts\": %u"
+		",\n\t\t\t\"load_ms\": %.3f"
+		",\n\t\t\t\"update_ms\": %.3f"
+		",\n\t\t\t\"style_ms\": %.3f"
+		",\n\t\t\t\"layout_ms\": %.3f"
+		",\n\t\t\t\"render_ms\": %.3f"
+		",\n\t\t\t\"max_frame_ms\": %.3f"
+		",\n\t\t\t\"layout_roots\": %.2f"
+		",\n\t\t\t\"layout_elements\": %.2f"
+		",\n\t\t\t\"draws\": %.2f"
+		",\n\t\t\t\"vertices\": %.2f"
+		",\n\t\t\t\"indices\": %.2f"
+		",\n\t\t\t\"bytes_uploaded\": %.2f"
+		",\n\t\t\t\"compiled_geometries\": %u"
+		",\n\t\t\t\"element_arena_bytes\": %llu"
+		",\n\t\t\t\"element_arena_allocations\": %llu",
+		num_contexts,
+		r.load_time * 1000.0,
+		r.update_time * ms,
+		r.style_time * ms,
+		r.layout_time * ms,
+		r.render_time * ms,
+		r.max_frame_time * 1000.0,
+		double(r.layout_roots) / frames,
+		double(r.layout_elements) / frames,
+		double(r.render_stats.draws) / frames,
+		double(r.render_stats.vertices) / frames,
+		double(r.render_stats.indices) / frames,
+		double(r.render_stats.bytes_uploaded) / frames,
+		r.compiled_geometries,
+		(unsigned long long)r.element_arena_bytes,
+		(unsigned long long)r.element_arena_allocations);
+}
+
+static const Rml::Vector2i CONTEXT_SIZE(1920, 1080);
+
+// each context shows the document, updated and rendered once
+static bool createContexts(const Rml::String& path, u32 num_contexts, CountingRenderInterface& render_interface, Array<Rml::Context*>& contexts) {
+	for (u32 i = 0; i < num_contexts; ++i) {
+		Rml::Context* context = Rml::CreateContext(Rml::CreateString(64, "rml_benchmark#%u", i), CONTEXT_SIZE, &render_interface);
+		contexts.push(context);
+		Rml::ElementDocument* document = context->LoadDocument(path);
+		if (!document) {
+			logError("Failed to load ", path.c_str());
+			return false;
+		}
+		document->Show();
+		context->Update();
+		context->Render();
+	}
+	return true;
+}
+
+static bool runDocument(const Rml::String& path, u32 num_contexts, u32 frames, CountingRenderInterface& render_interface, IAllocator& allocator, BenchmarkResult& result) {
+	Array<Rml::Context*> contexts(allocator);
+
+	os::Timer timer;
+	const bool success = createContexts(path, num_contexts, render_interface, contexts);
+	result.load_time = timer.tick();
+
+	render_interface.m_stats = {};
+	for (u32 frame = 0; success && frame < frames; ++frame) {
+		// hovering over different elements every frame restyles them, so the sweep covers style changes too
+		const int x = int(u64(frame) * 37 % CONTEXT_SIZE.x);
+		const int y = int(u64(frame) * 23 % CONTEXT_SIZE.y);
+		float frame_time = 0;
+		for (Rml::Context* context : contexts) {
+			timer.tick();
+			context->ProcessMouseMove(x, y, 0);
+			context->Update();
+			const float update_time = timer.tick();
+			context->Render();
+			const float render_time = timer.tick();
+
+			result.update_time += update_time;
+			result.style_time += context->GetStyleUpdateTime();
+			result.layout_time += context->GetLayoutUpdateTime();
+			result.render_time += render_time;
+			result.layout_roots += context->GetNumLayoutRoots();
+			result.layout_elements += context->GetNumLayoutElements();
+			frame_time += update_time + render_time;
+		}
+		result.max_frame_time = maximum(result.max_frame_time, frame_time);
+	}
+	result.render_stats = render_interface.m_stats;
+	result.compiled_geometries = render_interface.m_num_compiled_geometries;
+
+	for (Rml::Context* context : contexts) {
+		result.element_arena_bytes += context->GetNumElementArenaBytes();
+		result.element_arena_allocations += context->GetNumElementArenaAllocations();
+		Rml::RemoveContext(context->GetName());
+	}
+	return success;
+}
+
+// loads the document into `num_contexts` new contexts, once with rml's document cache dropped before every load and once with the cache
+static bool runLoad(const Rml::String& path, u32 num_contexts, CountingRenderInterface& render_interface, IAllocator& allocator, Rml::String& json) {
+	Array<Rml::Context*> contexts(allocator);
+	float load_times[2] = {};
+	bool success = true;
+
+	os::Timer timer;
+	for (u32 cached = 0; cached < 2 && success; ++cached) {
+		Rml::Factory::ClearDocumentCache();
+		for (u32 i = 0; i < num_contexts; ++i) {
+			if (!cached) Rml::Factory::ClearDocumentCache();
+			Rml::Context* context = Rml::CreateContext(Rml::CreateString(64, "rml_benchmark#%u", i), CONTEXT_SIZE, &render_interface);
+			contexts.push(context);
+			timer.tick();
+			Rml::ElementDocument* document = context->LoadDocument(path);
+			load_times[cached] += timer.tick();
+			if (!document) {
+				logError("Failed to load ", path.c_str());
+				success = false;
+				break;
+			}
+		}
+		for (Rml::Context* context : contexts) Rml::RemoveContext(context->GetName());
+		contexts.clear();
+	}
+
+	// the first cached load parses the document too
+	json += Rml::CreateString(256,
+		",\n\t\t\t\"contexts\": %u"
+		",\n\t\t\t\"uncached_load_ms\": %.3f"
+		",\n\t\t\t\"cached_load_ms\": %.3f",
+		num_contexts,
+		load_times[0] * 1000.0,
+		load_times[1] * 1000.0);
+	return success;
+}
+
+// runs the document in 1, 8 and 64 contexts, which are updated in parallel on jobs like the engine's canvases
+static bool runScaling(const Rml::String& path, u32 frames, CountingRenderInterface& render_interface, IAllocator& allocator, Rml::String& json) {
+	static const u32 CONTEXT_COUNTS[] = { 1, 8, 64 };
+	json += ",\n\t\t\t\"scaling\": [";
+	for (u32 c = 0; c < lengthOf(CONTEXT_COUNTS); ++c) {
+		Array<Rml::Context*> contexts(allocator);
+		bool success = createContexts(path, CONTEXT_COUNTS[c], render_interface, contexts);
+
+		float update_time = 0;
+		float render_time = 0;
+		float max_frame_time = 0;
+		os::Timer timer;
+		for (u32 frame = 0; success && frame < frames; ++frame) {
+			const int x = int(u64(frame) * 37 % CONTEXT_SIZE.x);
+			const int y = int(u64(frame) * 23 % CONTEXT_SIZE.y);
+			timer.tick();
+			for (Rml::Context* context : contexts) context->ProcessMouseMove(x, y, 0);
+			jobs::forEach(contexts.size(), 1, [&](i32 i, i32){
+				contexts[i]->Update();
+			});
+			const float frame_update_time = timer.tick();
+			for (Rml::Context* context : contexts) context->Render();
+			const float frame_render_time = timer.tick();
+
+			update_time += frame_update_time;
+			render_time += frame_render_time;
+			max_frame_time = maximum(max_frame_time, frame_update_time + frame_render_time);
+		}
+
+		for (Rml::Context* context : contexts) Rml::RemoveContext(context->GetName());
+		if (!success) return false;
+
+		// per frame for all contexts together, in milliseconds
+		const double ms = 1000.0 / frames;
+		json += Rml::CreateString(256, "%s\n\t\t\t\t{ \"contexts\": %u, \"update_ms\": %.3f, \"render_ms\": %.3f, \"max_frame_ms\": %.3f }",
+			c == 0 ? "" : ",",
+			CONTEXT_COUNTS[c],
+			update_time * ms,
+			render_time * ms,
+			max_frame_time * 1000.0);
+	}
+	json += "\n\t\t\t]";
+	return true;
+}
+
+// data bound by the generated expressions document
+struct ExpressionsModel {
+	struct Player {
+		Rml::String name = "player";
+		int level = 1;
+	};
+
+	int health = 100;
+	int ammo = 30;
+	float timer = 0;
+	bool alive = true;
+	Player player;
+	Rml::Vector<int> items = { 1, 2, 3 };
+};
+
+// generated documents use the font loaded in rml_system.cpp
+// every row evaluates text, class, style and if expressions, mixing variables, struct members, arrays and transforms
+static Rml::String generateExpressionsDocument(u32 rows) {
+	Rml::String rml =
+		"<rml><head><style>"
+		"body { font-family: Delicious; font-size: 14px; width: 100%; height: 100%; }"
+		"div { display: block; }"
+		".low { color: #f00; }"
+		".empty { color: #888; }"
+		"</style></head><body><div data-model=\"benchmark\">";
+	for (u32 i = 0; i < rows; ++i) {
+		rml += Rml::CreateString(1024,
+			"<div data-class-low=\"health < 25\" data-if=\"alive || ammo > %u\">"
+			"<span>{{ player.name | to_upper }} {{ player.level * 10 + health }}</span>"
+			"<span data-style-width=\"timer * 10 + 'px'\">{{ timer > 60 ? 'late' : 'on time' }}</span>"
+			"<span>{{ items[0] + items.size * ammo - %u }}</span>"
+			"<span data-class-empty=\"ammo == 0 && !alive\">{{ health / 100 * %u | format(1) }}</span>"
+			"</div>",
+			i % 31, i, i);
+	}
+	rml += "</div></body></rml>";
+	return rml;
+}
+
+// changes the bound variables every frame and updates the data model, once with compiled expressions and once with the interpreter
+static bool runExpressions(u32 rows, u32 frames, CountingRenderInterface& render_interface, Rml::String& json) {
+	const Rml::String rml = generateExpressionsDocument(rows);
+	float model_update_times[2] = {};
+	float update_times[2] = {};
+
+	os::Timer timer;
+	for (u32 compiled = 0; compiled < 2; ++compiled) {
+		ExpressionsModel model;
+		Rml::Context* context = Rml::CreateContext("rml_benchmark", CONTEXT_SIZE, &render_interface);
+		Rml::DataModelConstructor constructor = context->CreateDataModel("benchmark");
+		constructor.SetCompileExpressions(compiled != 0);
+		if (auto player = constructor.RegisterStruct<ExpressionsModel::Player>()) {
+			player.RegisterMember("name", &ExpressionsModel::Player::name);
+			player.RegisterMember("level", &ExpressionsModel::Player::level);
+		}
+		constructor.RegisterArray<Rml::Vector<int>>();
+		constructor.Bind("health", &model.health);
+		constructor.Bind("ammo", &model.ammo);
+		constructor.Bind("timer", &model.timer);
+		constructor.Bind("alive", &model.alive);
+		constructor.Bind("player", &model.player);
+		constructor.Bind("items", &model.items);
+		Rml::DataModelHandle handle = constructor.GetModelHandle();
+
+		Rml::ElementDocument* document = context->LoadDocumentFromMemory(rml);
+		if (!document) {
+			logError("Failed to load the generated expressions document");
+			Rml::RemoveContext(context->GetName());
+			return false;
+		}
+		document->Show();
+		handle.Update();
+		context->Update();
+		context->Render();
+
+		for (u32 frame = 0; frame < frames; ++frame) {
+			model.health = 100 - i32(frame % 100);
+			model.ammo = i32(frame % 31);
+			model.timer += 1 / 60.f;
+			model.alive = frame % 7 != 0;
+			handle.DirtyVariable("health");
+			handle.DirtyVariable("ammo");
+			handle.DirtyVariable("timer");
+			handle.DirtyVariable("alive");
+
+			timer.tick();
+			handle.Update();
+			model_update_times[compiled] += timer.tick();
+			context->Update();
+			update_times[compiled] += timer.tick();
+			context->Render();
+		}
+		Rml::RemoveContext(context->GetName());
+	}
+
+	// per frame in milliseconds, update is the context update after the model changed the elements
+	const double ms = 1000.0 / frames;
+	json += Rml::CreateString(256,
+		",\n\t\t\t\"rows\": %u"
+		",\n\t\t\t\"interpreted_model_update_ms\": %.3f"
+		",\n\t\t\t\"compiled_model_update_ms\": %.3f"
+		",\n\t\t\t\"interpreted_update_ms\": %.3f"
+		",\n\t\t\t\"compiled_update_ms\": %.3f",
+		rows,
+		model_update_times[0] * ms,
+		model_update_times[1] * ms,
+		update_times[0] * ms,
+		update_times[1] * ms);
+	return true;
+}
+
+struct ListRow {
+	Rml::String name;
+	int value = 0;
+};
+
+static const float LIST_ROW_HEIGHT = 24;
+
+static Rml::String generateListDocument(bool virtualized) {
+	return Rml::CreateString(1024,
+		"<rml><head><style>"
+		"body { font-family: Delicious; font-size: 14px; width: 100%%; height: 100%%; }"
+		"div { display: block; }"
+		"#viewport { height: 100%%; overflow-y: auto; }"
+		".row { height: %gpx; }"
+		"</style></head><body>"
+		"<div id=\"viewport\" data-model=\"benchmark\">"
+		"<div class=\"row\" data-for=\"row : rows\" %s><span>{{ it_index }}</span> <span>{{ row.name }}</span> <span>{{ row.value * 2 }}</span></div>"
+		"</div>"
+		"</body></rml>",
+		LIST_ROW_HEIGHT,
+		virtualized ? Rml::CreateString(64, "virtual-row-height=\"%g\"", LIST_ROW_HEIGHT).c_str() : "");
+}
+
+// a large bound array shown in a scrolled element, once instancing all rows and once virtualized,
+// scrolled by a few rows every frame and then resized every frame
+static bool runList(u32 rows, u32 frames, CountingRenderInterface& render_interface, Rml::String& json) {
+	Rml::Vector<ListRow> list(rows);
+	for (u32 i = 0; i < rows; ++i) {
+		list[i].name = Rml::CreateString(32, "row %u", i);
+		list[i].value = i32(i);
+	}
+
+	json += Rml::CreateString(64, ",\n\t\t\t\"rows\": %u,\n\t\t\t\"list\": [", rows);
+	os::Timer timer;
+	for (u32 virtualized = 0; virtualized < 2; ++virtualized) {
+		Rml::Context* context = Rml::CreateContext("rml_benchmark", CONTEXT_SIZE, &render_interface);
+		Rml::DataModelConstructor constructor = context->CreateDataModel("benchmark");
+		if (auto row = constructor.RegisterStruct<ListRow>()) {
+			row.RegisterMember("name", &ListRow::name);
+			row.RegisterMember("value", &ListRow::value);
+		}
+		constructor.RegisterArray<Rml::Vector<ListRow>>();
+		constructor.Bind("rows", &list);
+		Rml::DataModelHandle handle = constructor.GetModelHandle();
+
+		// first update and layout of the whole list
+		timer.tick();
+		Rml::ElementDocument* document = context->LoadDocumentFromMemory(generateListDocument(virtualized != 0));
+		if (!document) {
+			logError("Failed to load the generated list document");
+			Rml::RemoveContext(context->GetName());
+			return false;
+		}
+		document->Show();
+		handle.Update();
+		context->Update();
+		context->Render();
+		const float build_time = timer.tick();
+
+		Rml::Element* viewport = document->GetElementById("viewport");
+		const u32 scroll_rows = maximum(u32((viewport->GetScrollHeight() - viewport->GetClientHeight()) / LIST_ROW_HEIGHT), 1u);
+		float scroll_time = 0;
+		for (u32 frame = 0; frame < frames; ++frame) {
+			timer.tick();
+			viewport->SetScrollTop(float(frame * 5 % scroll_rows) * LIST_ROW_HEIGHT);
+			handle.Update();
+			context->Update();
+			context->Render();
+			scroll_time += timer.tick();
+		}
+
+		float resize_time = 0;
+		for (u32 frame = 0; frame < frames; ++frame) {
+			timer.tick();
+			context->SetDimensions(frame % 2 ? CONTEXT_SIZE : Rml::Vector2i(CONTEXT_SIZE.x / 2, CONTEXT_SIZE.y / 2));
+			handle.Update();
+			context->Update();
+			context->Render();
+			resize_time += timer.tick();
+		}
+		const int viewport_children = viewport->GetNumChildren();
+		Rml::RemoveContext(context->GetName());
+
+		// scroll and resize are per frame, in milliseconds
+		const double ms = 1000.0 / frames;
+		json += Rml::CreateString(256, "%s\n\t\t\t\t{ \"virtual\": %s, \"build_ms\": %.3f, \"scroll_ms\": %.3f, \"resize_ms\": %.3f, \"viewport_children\": %d }",
+			virtualized ? "," : "",
+			virtualized ? "true" : "false",
+			build_time * 1000.0,
+			scroll_time * ms,
+			resize_time * ms,
+			viewport_children);
+	}
+	json += "\n\t\t\t]";
+	return true;
+}
+
+static void collectElements(Rml::Element* element, Array<Rml::Element*>& elements) {
+	for (int i = 0, c = element->GetNumChildren(); i < c; ++i) {
+		Rml::Element* child = element->GetChild(i);
+		// skip text
+		if (child->GetTagName()[0] == '#') continue;
+		elements.push(child);
+		collectElements(child, elements);
+	}
+}
+
+// every frame one element, round-robin, loses its first class and gets it back the next frame,
+// then the same with :hover on all elements, only the context update is timed
+static bool runRestyle(const Rml::String& path, u32 frames, CountingRenderInterface& render_interface, IAllocator& allocator, Rml::String& json) {
+	Array<Rml::Context*> contexts(allocator);
+	if (!createContexts(path, 1, render_interface, contexts)) {
+		Rml::RemoveContext(contexts[0]->GetName());
+		return false;
+	}
+	Rml::Context* context = contexts[0];
+
+	Array<Rml::Element*> elements(allocator);
+	Array<Rml::Element*> classed_elements(allocator);
+	for (int i = 0, c = context->GetNumDocuments(); i < c; ++i) collectElements(context->GetDocument(i), elements);
+	for (Rml::Element* element : elements) {
+		Rml::StringList classes;
+		Rml::StringUtilities::ExpandString(classes, element->GetClassNames(), ' ');
+		if (!classes.empty() && !classes[0].empty()) classed_elements.push(element);
+	}
+
+	float update_times[2] = {};
+	double style_times[2] = {};
+	// class removed on even frames and added back on the following odd frame
+	Rml::String removed_class;
+	os::Timer timer;
+	for (u32 pseudo_class = 0; pseudo_class < 2; ++pseudo_class) {
+		const Array<Rml::Element*>& targets = pseudo_class ? elements : classed_elements;
+		if (targets.empty()) continue;
+		for (u32 frame = 0; frame < frames; ++frame) {
+			Rml::Element* element = targets[frame / 2 % targets.size()];
+			const bool toggled = frame % 2 == 0;
+			if (pseudo_class) {
+				element->SetPseudoClass("hover", toggled);
+			}
+			else if (toggled) {
+				Rml::StringList classes;
+				Rml::StringUtilities::ExpandString(classes, element->GetClassNames(), ' ');
+				removed_class = classes[0];
+				element->SetClass(removed_class, false);
+			}
+			else {
+				element->SetClass(removed_class, true);
+			}
+			timer.tick();
+			context->Update();
+			update_times[pseudo_class] += timer.tick();
+			style_times[pseudo_class] += context->GetStyleUpdateTime();
+			context->Render();
+		}
+	}
+	Rml::RemoveContext(context->GetName());
+
+	// per frame in milliseconds
+	const double ms = 1000.0 / frames;
+	json += Rml::CreateString(512,
+		",\n\t\t\t\"elements\": %u"
+		",\n\t\t\t\"classed_elements\": %u"
+		",\n\t\t\t\"class_update_ms\": %.3f"
+		",\n\t\t\t\"class_style_ms\": %.3f"
+		",\n\t\t\t\"pseudo_class_update_ms\": %.3f"
+		",\n\t\t\t\"pseudo_class_style_ms\": %.3f",
+		elements.size(),
+		classed_elements.size(),
+		update_times[0] * ms,
+		style_times[0] * ms,
+		update_times[1] * ms,
+		style_times[1] * ms);
+	return true;
+}
+
+// queries a grid of points over the context every frame, first with unchanged layout,
+// then with the context resized before every frame so the queries run right after a layout change
+static bool runHitTest(const Rml::String& path, u32 frames, CountingRenderInterface& render_interface, IAllocator& allocator, Rml::String& json) {
+	Array<Rml::Context*> contexts(allocator);
+	if (!createContexts(path, 1, render_interface, contexts)) {
+		Rml::RemoveContext(contexts[0]->GetName());
+		return false;
+	}
+	Rml::Context* context = contexts[0];
+
+	static const int STEP = 16;
+	const u32 queries_per_frame = u32((CONTEXT_SIZE.x / STEP) * (CONTEXT_SIZE.y / STEP));
+	float query_times[2] = {};
+	os::Timer timer;
+	for (u32 relayout = 0; relayout < 2; ++relayout) {
+		for (u32 frame = 0; frame < frames; ++frame) {
+			if (relayout) context->SetDimensions(frame % 2 ? CONTEXT_SIZE : Rml::Vector2i(CONTEXT_SIZE.x - STEP, CONTEXT_SIZE.y));
+			context->Update();
+			timer.tick();
+			for (int y = 0; y < CONTEXT_SIZE.y / STEP; ++y) {
+				for (int x = 0; x < CONTEXT_SIZE.x / STEP; ++x) {
+					context->GetElementAtPoint(Rml::Vector2f(float(x * STEP), float(y * STEP)));
+				}
+			}
+			query_times[relayout] += timer.tick();
+			context->Render();
+		}
+	}
+	Rml::RemoveContext(context->GetName());
+
+	// microseconds per query
+	const double us = 1000000.0 / (double(frames) * queries_per_frame);
+	json += Rml::CreateString(256,
+		",\n\t\t\t\"queries_per_frame\": %u"
+		",\n\t\t\t\"query_us\": %.4f"
+		",\n\t\t\t\"relayout_query_us\": %.4f",
+		queries_per_frame,
+		query_times[0] * us,
+		query_times[1] * us);
+	return true;
+}
+
+bool runRmlBenchmark(const char* corpus, u32 frames, IAllocator& allocator, OutputMemoryStream& out) {
+	ASSERT(frames > 0);
+	Rml::StringList lines;
+	Rml::StringUtilities::ExpandString(lines, corpus, '\n');
+
+	CountingRenderInterface render_interface(allocator);
+	bool success = true;
+	bool first = true;
+	Rml::String json = Rml::CreateString(64, "{\n\t\"frames\": %u,\n\t\"documents\": [", frames);
+	for (const Rml::String& line : lines) {
+		if (line.empty() || line[0] == '#') continue;
+
+		Rml::String path = line;
+		const BenchmarkMode mode = parseMode(path);
+		// number of contexts, or the size of generated documents, which take only the number
+		u32 count = 0;
+		const size_t separator = path.find_last_of(" \t");
+		const size_t count_start = separator == Rml::String::npos ? 0 : separator + 1;
+		if (count_start < path.size() && path.find_first_not_of("0123456789", count_start) == Rml::String::npos) {
+			count = atoi(path.c_str() + count_start);
+			path = separator == Rml::String::npos ? Rml::String() : path.substr(0, path.find_last_not_of(" \t", separator) + 1);
+		}
+		const u32 num_contexts = maximum(count, 1u);
+
+		Rml::String fields;
+		bool ran = false;
+		switch (mode) {
+			case BenchmarkMode::FRAMES: {
+				BenchmarkResult r;
+				ran = runDocument(path, num_contexts, frames, render_interface, allocator, r);
+				writeResult(fields, r, num_contexts, frames);
+				break;
+			}
+			case BenchmarkMode::LOAD: ran = runLoad(path, num_contexts, render_interface, allocator, fields); break;
+			case BenchmarkMode::SCALING: ran = runScaling(path, frames, render_interface, allocator, fields); break;
+			case BenchmarkMode::EXPRESSIONS: ran = runExpressions(count ? count : 200, frames, render_interface, fields); break;
+			case BenchmarkMode::LIST: ran = runList(count ? count : 5000, frames, render_interface, fields); break;
+			case BenchmarkMode::RESTYLE: ran = runRestyle(path, frames, render_interface, allocator, fields); break;
+			case BenchmarkMode::HIT_TEST: ran = runHitTest(path, frames, render_interface, allocator, fields); break;
+		}
+		if (!ran) {
+			success = false;
+			continue;
+		}
+
+		json += first ? "\n\t\t{" : ",\n\t\t{";
+		first = false;
+		json += Rml::CreateString(64, "\n\t\t\t\"mode\": \"%s\"", MODE_NAMES[(u32)mode]);
+		if (!path.empty()) {
+			json += ",\n\t\t\t\"path\": ";
+			writeJSONString(json, path);
+		}
+		json += fields;
+		json += "\n\t\t}";
+	}
+	json += "\n\t]\n}\n";
+
+	// rml's texture database outlives the render interface
+	Rml::ReleaseTextures(&render_interface);
+	out.write(json.data(), json.size());
+	return success;
+}
+
+} // namespace Lumix
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "engine/lumix.h"
+
+namespace Lumix {
+
+struct IAllocator;
+struct OutputMemoryStream;
+
+// loads rml documents into offscreen contexts and measures their update, layout and render, without GPU or world
+// rml must be initialized, documents and the textures they use are read through rml's file interface
+// `corpus` lists one document per line, optionally followed by the number of contexts showing it at once, e.g. `ui/hud.rml 8`
+// empty lines and lines starting with # are skipped
+// a line can start with a mode, e.g. `load: ui/hud.rml 16`, results are written to `out` as json
+// 	frames (default): the document runs for `frames` frames with mouse sweeping over it
+// 	load: the document is loaded into the contexts without and with rml's document cache
+// 	scaling: the document runs in 1, 8 and 64 contexts updated in parallel on jobs, the number of contexts is ignored
+// 	expressions: a generated document with data bindings, compiled vs interpreted expressions, takes only a number of rows, e.g. `expressions: 500`
+// 	list: a generated data-for list of the given number of rows, with and without virtualization, scrolled and resized every frame
+// 	restyle: the document in one context, toggling a class and then :hover of one element per frame
+// 	hit_test: the document in one context, queried for the element at points on a 16px grid every frame, also right after relayout
+bool runRmlBenchmark(const char* corpus, u32 frames, IAllocator& allocator, OutputMemoryStream& out);
+
+} // namespace Lumix
\ No newline at end of file
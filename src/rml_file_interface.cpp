@@ -0,0 +1,204 @@
+#define LUMIX_NO_CUSTOM_CRT
+#include "rml_file_interface.h"
+#include "RmlUi/Core/Core.h"
+#include "RmlUi/Core/SystemInterface.h"
+#include "engine/allocator.h"
+#include "engine/log.h"
+#include <stdio.h>
+
+namespace Lumix {
+
+RmlFileInterface::RmlFileInterface(FileSystem& fs, IAllocator& allocator, u64 budget)
+	: m_fs(fs)
+	, m_allocator(allocator)
+	, m_budget(budget)
+	, m_cache(allocator)
+	, m_prefetches(allocator)
+{}
+
+RmlFileInterface::~RmlFileInterface() {
+	for (PrefetchRequest* req : m_prefetches) {
+		m_fs.cancel(req->handle);
+		LUMIX_DELETE(m_allocator, req);
+	}
+	for (CacheEntry* entry : m_cache) {
+		ASSERT(entry->open_count == 0);
+		LUMIX_DELETE(m_allocator, entry);
+	}
+}
+
+RmlFileInterface::CacheEntry* RmlFileInterface::find(const Path& path) {
+	for (CacheEntry* entry : m_cache) {
+		if (entry->path == path) {
+			entry->last_used = ++m_use_counter;
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+RmlFileInterface::CacheEntry* RmlFileInterface::insert(const Path& path, Span<const u8> data) {
+	CacheEntry* entry = LUMIX_NEW(m_allocator, CacheEntry)(path, m_allocator);
+	entry->data.write(data.begin(), data.length());
+	entry->last_used = ++m_use_counter;
+	entry->last_modified = m_fs.getLastModified(path.c_str());
+	m_cache.push(entry);
+	m_cached_bytes += data.length();
+	evict();
+	return entry;
+}
+
+// drops least recently used files until we fit in the budget, files which are open or were just used are kept
+void RmlFileInterface::evict() {
+	while (m_cached_bytes > m_budget) {
+		i32 lru = -1;
+		for (i32 i = 0, c = m_cache.size(); i < c; ++i) {
+			const CacheEntry* entry = m_cache[i];
+			if (entry->open_count > 0 || entry->last_used == m_use_counter) continue;
+			if (lru < 0 || entry->last_used < m_cache[lru]->last_used) lru = i;
+		}
+		if (lru < 0) return;
+
+		erase(m_cache[lru]);
+	}
+}
+
+void RmlFileInterface::erase(CacheEntry* entry) {
+	m_cached_bytes -= entry->data.size();
+	m_cache.eraseItem(entry);
+	LUMIX_DELETE(m_allocator, entry);
+}
+
+RmlFileInterface::CacheEntry* RmlFileInterface::load(const Path& path) {
+	if (CacheEntry* entry = find(path)) {
+		if (entry->open_count > 0 || m_fs.getLastModified(path.c_str()) == entry->last_modified) return entry;
+		erase(entry);
+	}
+
+	OutputMemoryStream content(m_allocator);
+	if (!m_fs.getContentSync(path, content)) return nullptr;
+	return insert(path, Span<const u8>(content.data(), (u32)content.size()));
+}
+
+Rml::FileHandle RmlFileInterface::Open(const Rml::String& path) {
+	CacheEntry* entry = load(Path(path.c_str()));
+	if (!entry) return 0;
+
+	++entry->open_count;
+	OpenFile* file = LUMIX_NEW(m_allocator, OpenFile);
+	file->entry = entry;
+	return (Rml::FileHandle)file;
+}
+
+void RmlFileInterface::Close(Rml::FileHandle file) {
+	OpenFile* f = (OpenFile*)file;
+	ASSERT(f->entry->open_count > 0);
+	--f->entry->open_count;
+	LUMIX_DELETE(m_allocator, f);
+	evict();
+}
+
+size_t RmlFileInterface::Read(void* buffer, size_t size, Rml::FileHandle file) {
+	OpenFile* f = (OpenFile*)file;
+	const u64 to_read = minimum(u64(size), f->entry->data.size() - f->pos);
+	memcpy(buffer, f->entry->data.data() + f->pos, to_read);
+	f->pos += to_read;
+	return (size_t)to_read;
+}
+
+bool RmlFileInterface::Seek(Rml::FileHandle file, long offset, int origin) {
+	OpenFile* f = (OpenFile*)file;
+	i64 pos;
+	switch (origin) {
+		case SEEK_SET: pos = offset; break;
+		case SEEK_CUR: pos = i64(f->pos) + offset; break;
+		case SEEK_END: pos = i64(f->entry->data.size()) + offset; break;
+		default: return false;
+	}
+	if (pos < 0 || pos > i64(f->entry->data.size())) return false;
+	f->pos = u64(pos);
+	return true;
+}
+
+size_t RmlFileInterface::Tell(Rml::FileHandle file) {
+	return (size_t)((OpenFile*)file)->pos;
+}
+
+size_t RmlFileInterface::Length(Rml::FileHandle file) {
+	return (size_t)((OpenFile*)file)->entry->data.size();
+}
+
+bool RmlFileInterface::LoadFile(const Rml::String& path, Rml::String& out_data) {
+	const CacheEntry* entry = load(Path(path.c_str()));
+	if (!entry) return false;
+
+	out_data.assign((const char*)entry->data.data(), (size_t)entry->data.size());
+	return true;
+}
+
+void RmlFileInterface::prefetchDocument(const Path& path) {
+	if (CacheEntry* entry = find(path)) {
+		prefetchDependencies(*entry);
+		return;
+	}
+	prefetchFile(path);
+}
+
+// cached files are not scanned again, so we do not loop forever on documents linking each other
+void RmlFileInterface::prefetchFile(const Path& path) {
+	if (find(path)) return;
+	for (PrefetchRequest* req : m_prefetches) {
+		if (req->path == path) return;
+	}
+
+	PrefetchRequest* req = LUMIX_NEW(m_allocator, PrefetchRequest);
+	req->file_interface = this;
+	req->path = path;
+	m_prefetches.push(req);
+	FileSystem::ContentCallback cb;
+	cb.bind<&PrefetchRequest::onLoaded>(req);
+	req->handle = m_fs.getContent(path, cb);
+}
+
+void RmlFileInterface::PrefetchRequest::onLoaded(Span<const u8> data, bool success) {
+	RmlFileInterface* fi = file_interface;
+	fi->m_prefetches.eraseItem(this);
+
+	if (!success) {
+		logError("Failed to prefetch ", path);
+	}
+	else if (!fi->find(path)) {
+		// document might have been loaded synchronously while we were waiting
+		CacheEntry* entry = fi->insert(path, data);
+		fi->prefetchDependencies(*entry);
+	}
+	LUMIX_DELETE(fi->m_allocator, this);
+}
+
+// looks for <link href="..."> in rml documents and templates, stylesheets have no file dependencies
+void RmlFileInterface::prefetchDependencies(const CacheEntry& entry) {
+	const Rml::String content((const char*)entry.data.data(), (size_t)entry.data.size());
+	const Rml::String document_path = entry.path.c_str();
+	Rml::SystemInterface* system_interface = Rml::GetSystemInterface();
+
+	size_t pos = 0;
+	while ((pos = content.find("<link", pos)) != Rml::String::npos) {
+		const size_t tag_end = content.find('>', pos);
+		if (tag_end == Rml::String::npos) break;
+
+		const size_t href = content.find("href", pos);
+		pos = tag_end;
+		if (href == Rml::String::npos || href > tag_end) continue;
+
+		const size_t value_begin = content.find_first_of("\"'", href);
+		if (value_begin == Rml::String::npos || value_begin > tag_end) continue;
+		const size_t value_end = content.find(content[value_begin], value_begin + 1);
+		if (value_end == Rml::String::npos || value_end > tag_end) continue;
+
+		Rml::String dependency;
+		system_interface->JoinPath(dependency, document_path, content.substr(value_begin + 1, value_end - value_begin - 1));
+		prefetchFile(Path(dependency.c_str()));
+	}
+}
+
+} // namespace Lumix
\ No newline at end of file
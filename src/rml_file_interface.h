@@ -0,0 +1,69 @@
+#pragma once
+
+#include "RmlUi/Core/FileInterface.h"
+#include "engine/array.h"
+#include "engine/file_system.h"
+#include "engine/path.h"
+#include "engine/stream.h"
+
+namespace Lumix {
+
+// routes rml's file access through Lumix's filesystem, so it works with packed archives
+// loaded files are kept in a LRU cache shared by all contexts, limited to `budget` bytes
+// files modified on disk are loaded again, so rml's document cache sees the new content
+struct RmlFileInterface : Rml::FileInterface {
+	RmlFileInterface(FileSystem& fs, IAllocator& allocator, u64 budget);
+	~RmlFileInterface();
+
+	Rml::FileHandle Open(const Rml::String& path) override;
+	void Close(Rml::FileHandle file) override;
+	size_t Read(void* buffer, size_t size, Rml::FileHandle file) override;
+	bool Seek(Rml::FileHandle file, long offset, int origin) override;
+	size_t Tell(Rml::FileHandle file) override;
+	size_t Length(Rml::FileHandle file) override;
+	bool LoadFile(const Rml::String& path, Rml::String& out_data) override;
+
+	// asynchronously loads the document and everything it links (stylesheets, templates) into the cache
+	void prefetchDocument(const Path& path);
+	u64 getCachedBytes() const { return m_cached_bytes; }
+
+private:
+	struct CacheEntry {
+		CacheEntry(const Path& path, IAllocator& allocator) : path(path), data(allocator) {}
+		Path path;
+		OutputMemoryStream data;
+		u64 last_used = 0;
+		u64 last_modified = 0;
+		u32 open_count = 0;
+	};
+
+	struct OpenFile {
+		CacheEntry* entry;
+		u64 pos = 0;
+	};
+
+	struct PrefetchRequest {
+		void onLoaded(Span<const u8> data, bool success);
+		RmlFileInterface* file_interface;
+		Path path;
+		FileSystem::AsyncHandle handle;
+	};
+
+	CacheEntry* find(const Path& path);
+	CacheEntry* insert(const Path& path, Span<const u8> data);
+	CacheEntry* load(const Path& path);
+	void erase(CacheEntry* entry);
+	void evict();
+	void prefetchFile(const Path& path);
+	void prefetchDependencies(const CacheEntry& entry);
+
+	FileSystem& m_fs;
+	IAllocator& m_allocator;
+	u64 m_budget;
+	u64 m_cached_bytes = 0;
+	u64 m_use_counter = 0;
+	Array<CacheEntry*> m_cache;
+	Array<PrefetchRequest*> m_prefetches;
+};
+
+} // namespace Lumix
\ No newline at end of file
@@ -1,13 +1,18 @@
 #define LUMIX_NO_CUSTOM_CRT
 #include "rml_module.h"
+#include "rml_file_interface.h"
 #include "RmlUi/Core.h"
 #include "engine/engine.h"
 #include "engine/geometry.h"
 #include "engine/input_system.h"
+#include "engine/job_system.h"
+#include "engine/log.h"
 #include "engine/math.h"
 #include "engine/os.h"
+#include "engine/profiler.h"
 #include "engine/reflection.h"
 #include "engine/resource_manager.h"
+#include "engine/sync.h"
 #include "engine/world.h"
 #include "renderer/draw_stream.h"
 #include "renderer/pipeline.h"
@@ -23,11 +28,239 @@ static const ComponentType RML_CANVAS_TYPE = reflection::getComponentType("rml_c
 struct RmlRenderInterface : Rml::RenderInterface {
 	RmlRenderInterface(Engine& engine, IAllocator& allocator)
 		: m_allocator(allocator)
-		, m_engine(engine) {}
+		, m_engine(engine)
+		, m_compiled_geometries(allocator)
+		, m_batch_vertices(allocator)
+		, m_batch_indices(allocator)
+		, m_textures(allocator)
+		, m_pending_textures(allocator)
+		, m_loaded_textures(allocator)
+		, m_deferred_textures(allocator)
+		, m_deferred_releases(allocator) {}
+
+	struct CompiledGeometry {
+		gpu::BufferHandle vb = gpu::INVALID_BUFFER;
+		gpu::BufferHandle ib = gpu::INVALID_BUFFER;
+		u32 vb_capacity = 0;
+		u32 ib_capacity = 0;
+		u32 num_indices = 0;
+		Rml::TextureHandle texture = 0;
+		i32 next_free = -1;
+	};
+
+	struct RmlTexture {
+		Path path; // empty for generated textures
+		Texture* resource = nullptr; // loaded from file, null until the load is started
+		gpu::TextureHandle handle = gpu::INVALID_TEXTURE; // generated by rml, e.g. font atlas
+		u32 ref_count = 0;
+		i32 next_free = -1;
+	};
+
+	// rml render calls of a canvas, replayed instead of Context::Render while the context does not change
+	struct RenderCommand {
+		enum class Type : u8 { GEOMETRY, COMPILED_GEOMETRY, ENABLE_SCISSOR, SET_SCISSOR };
+		Type type;
+		bool enable_scissor = false;
+		IVec4 scissor;
+		Rml::CompiledGeometryHandle geometry = 0;
+		Rml::TextureHandle texture = 0;
+		Rml::Vector2f translation;
+		// ranges in RenderCommands::vertices and indices, used by GEOMETRY
+		u32 first_vertex = 0;
+		u32 num_vertices = 0;
+		u32 first_index = 0;
+		u32 num_indices = 0;
+	};
+
+	struct RenderCommands {
+		RenderCommands(IAllocator& allocator) : commands(allocator), vertices(allocator), indices(allocator) {}
+
+		void clear() {
+			commands.clear();
+			vertices.clear();
+			indices.clear();
+		}
+
+		Array<RenderCommand> commands;
+		Array<Rml::Vertex> vertices;
+		Array<int> indices;
+	};
 
 	void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override {
 		if (!num_indices) return;
+
+		if (m_recording) {
+			RenderCommand& cmd = m_recording->commands.emplace();
+			cmd.type = RenderCommand::Type::GEOMETRY;
+			cmd.texture = texture;
+			cmd.translation = translation;
+			cmd.first_vertex = m_recording->vertices.size();
+			cmd.num_vertices = num_vertices;
+			cmd.first_index = m_recording->indices.size();
+			cmd.num_indices = num_indices;
+			m_recording->vertices.resize(cmd.first_vertex + num_vertices);
+			memcpy(m_recording->vertices.begin() + cmd.first_vertex, vertices, num_vertices * sizeof(vertices[0]));
+			m_recording->indices.resize(cmd.first_index + num_indices);
+			memcpy(m_recording->indices.begin() + cmd.first_index, indices, num_indices * sizeof(indices[0]));
+		}
 		
+		++m_stats.draws_submitted;
+		batch(vertices, num_vertices, (const u32*)indices, num_indices, texture, translation);
+	}
+
+	// appends immediate geometry to the pending batch, translation is baked into the vertices so consecutive draws with the same texture and scissor end up in one draw call
+	void batch(const Rml::Vertex* vertices, u32 num_vertices, const u32* indices, u32 num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) {
+		if (!m_batch_indices.empty() && texture != m_batch_texture) flushBatch();
+		m_batch_texture = texture;
+
+		const u32 base_vertex = m_batch_vertices.size();
+		m_batch_vertices.resize(base_vertex + num_vertices);
+		Rml::Vertex* dst_vertices = m_batch_vertices.begin() + base_vertex;
+		for (u32 i = 0; i < num_vertices; ++i) {
+			dst_vertices[i] = vertices[i];
+			dst_vertices[i].position += translation;
+		}
+
+		const u32 base_index = m_batch_indices.size();
+		m_batch_indices.resize(base_index + num_indices);
+		u32* dst_indices = m_batch_indices.begin() + base_index;
+		for (u32 i = 0; i < num_indices; ++i) {
+			dst_indices[i] = indices[i] + base_vertex;
+		}
+	}
+
+	void flushBatch() {
+		if (m_batch_indices.empty()) return;
+
+		const u32 vb_size = m_batch_vertices.size() * sizeof(Rml::Vertex);
+		const u32 ib_size = m_batch_indices.size() * sizeof(u32);
+		const Renderer::TransientSlice vb = m_renderer->allocTransient(vb_size);
+		const Renderer::TransientSlice ib = m_renderer->allocTransient(ib_size);
+		memcpy(vb.ptr, m_batch_vertices.begin(), vb_size);
+		memcpy(ib.ptr, m_batch_indices.begin(), ib_size);
+		m_stats.bytes_uploaded += vb_size + ib_size;
+
+		draw(vb.buffer, vb.offset, ib.buffer, ib.offset, m_batch_indices.size(), m_batch_texture, Rml::Vector2f(0, 0));
+		m_batch_vertices.clear();
+		m_batch_indices.clear();
+	}
+
+	~RmlRenderInterface() {
+		if (m_renderer) {
+			DrawStream& stream = m_renderer->getDrawStream();
+			for (CompiledGeometry& g : m_compiled_geometries) {
+				if (g.vb != gpu::INVALID_BUFFER) stream.destroy(g.vb);
+				if (g.ib != gpu::INVALID_BUFFER) stream.destroy(g.ib);
+			}
+			for (RmlTexture& t : m_textures) {
+				if (t.handle != gpu::INVALID_TEXTURE) stream.destroy(t.handle);
+			}
+		}
+		for (RmlTexture& t : m_textures) {
+			if (t.resource) t.resource->decRefCount();
+		}
+		if (m_shader) m_shader->decRefCount();
+	}
+
+	// geometry buffers are never destroyed when rml releases them, they go to a free list and are reused by following CompileGeometry calls
+	// compiled geometry is not batched, so geometry which does not change is uploaded only once
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) override {
+		if (!num_indices || !m_draw_stream) return 0;
+
+		const u32 vb_size = num_vertices * sizeof(vertices[0]);
+		const u32 ib_size = num_indices * sizeof(indices[0]);
+		MutexGuard guard(m_geometry_mutex);
+		const i32 idx = allocCompiledGeometry(vb_size, ib_size);
+		CompiledGeometry& g = m_compiled_geometries[idx];
+		g.num_indices = num_indices;
+		g.texture = texture;
+
+		const Renderer::MemRef vertices_mem = m_renderer->copy(vertices, vb_size);
+		const Renderer::MemRef indices_mem = m_renderer->copy(indices, ib_size);
+		m_draw_stream->update(g.vb, vertices_mem.data, vertices_mem.size);
+		m_draw_stream->update(g.ib, indices_mem.data, indices_mem.size);
+		m_draw_stream->freeMemory(vertices_mem.data, m_renderer->getAllocator());
+		m_draw_stream->freeMemory(indices_mem.data, m_renderer->getAllocator());
+		m_stats.bytes_uploaded += vb_size + ib_size;
+
+		return Rml::CompiledGeometryHandle(idx + 1);
+	}
+
+	void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override {
+		if (m_recording) {
+			RenderCommand& cmd = m_recording->commands.emplace();
+			cmd.type = RenderCommand::Type::COMPILED_GEOMETRY;
+			cmd.geometry = geometry;
+			cmd.translation = translation;
+		}
+
+		++m_stats.draws_submitted;
+		flushBatch();
+		const CompiledGeometry& g = m_compiled_geometries[i32(geometry) - 1];
+		draw(g.vb, 0, g.ib, 0, g.num_indices, g.texture, translation);
+	}
+
+	// rml releases geometry while updating contexts, i.e. from jobs
+	void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override {
+		MutexGuard guard(m_geometry_mutex);
+		const i32 idx = i32(geometry) - 1;
+		m_compiled_geometries[idx].next_free = m_first_free_geometry;
+		m_first_free_geometry = idx;
+	}
+
+	// returns index of geometry with buffers big enough, recycled from the free list if possible
+	i32 allocCompiledGeometry(u32 vb_size, u32 ib_size) {
+		i32* prev_link = &m_first_free_geometry;
+		while (*prev_link >= 0) {
+			CompiledGeometry& g = m_compiled_geometries[*prev_link];
+			if (g.vb_capacity >= vb_size && g.ib_capacity >= ib_size) {
+				const i32 idx = *prev_link;
+				*prev_link = g.next_free;
+				g.next_free = -1;
+				return idx;
+			}
+			prev_link = &g.next_free;
+		}
+
+		i32 idx;
+		if (m_first_free_geometry >= 0) {
+			// nothing in the free list is big enough, grow the first free one
+			idx = m_first_free_geometry;
+			CompiledGeometry& g = m_compiled_geometries[idx];
+			m_first_free_geometry = g.next_free;
+			g.next_free = -1;
+			m_draw_stream->destroy(g.vb);
+			m_draw_stream->destroy(g.ib);
+		}
+		else {
+			idx = m_compiled_geometries.size();
+			m_compiled_geometries.emplace();
+		}
+
+		CompiledGeometry& g = m_compiled_geometries[idx];
+		g.vb_capacity = maximum(vb_size, g.vb_capacity);
+		g.ib_capacity = maximum(ib_size, g.ib_capacity);
+		g.vb = gpu::allocBufferHandle();
+		g.ib = gpu::allocBufferHandle();
+		m_draw_stream->createBuffer(g.vb, gpu::BufferFlags::NONE, g.vb_capacity, nullptr);
+		m_draw_stream->createBuffer(g.ib, gpu::BufferFlags::NONE, g.ib_capacity, nullptr);
+		return idx;
+	}
+
+	void draw(gpu::BufferHandle vb, u32 vb_offset, gpu::BufferHandle ib, u32 ib_offset, u32 num_indices, Rml::TextureHandle texture_handle, const Rml::Vector2f& translation) {
+		gpu::TextureHandle texture = gpu::INVALID_TEXTURE;
+		if (texture_handle) {
+			const RmlTexture& t = m_textures[i32(texture_handle - 1)];
+			if (!t.path.isEmpty()) {
+				// still loading, skip the draw instead of showing it untextured
+				if (!t.resource || !t.resource->isReady()) return;
+				texture = t.resource->handle;
+			}
+			else {
+				texture = t.handle;
+			}
+		}
+
 		struct UBData {
 			Quat rot;
 			Vec4 pos;
@@ -40,62 +273,174 @@ struct RmlRenderInterface : Rml::RenderInterface {
 		data.rot = m_rot;
 		data.translation = translation;		
 		memcpy(ub.ptr, &data, sizeof(data));
+		++m_stats.draws_emitted;
 
-		gpu::BufferHandle vb = gpu::allocBufferHandle(); // TODO reuse
-		gpu::BufferHandle ib = gpu::allocBufferHandle(); // TODO reuse
-
-		const Renderer::MemRef vertices_mem = m_renderer->copy(vertices, num_vertices * sizeof(vertices[0]));
-		const Renderer::MemRef indices_mem = m_renderer->copy(indices, num_indices * sizeof(indices[0]));
-
-		m_draw_stream->createBuffer(vb, gpu::BufferFlags::NONE, vertices_mem.size, vertices_mem.data);
-		m_draw_stream->createBuffer(ib, gpu::BufferFlags::NONE, indices_mem.size, indices_mem.data);
+		if (m_scissor_dirty) applyScissor();
 		m_draw_stream->useProgram(m_is_3d ? m_program_3D : m_program_2D);
-
-		gpu::TextureHandle t = (gpu::TextureHandle)texture;
-		m_draw_stream->bindTextures(&t, 0, 1);
-
+		m_draw_stream->bindTextures(&texture, 0, 1);
 		m_draw_stream->bindUniformBuffer(UniformBuffer::DRAWCALL, ub.buffer, ub.offset, ub.size);
 		m_draw_stream->bindIndexBuffer(ib);
-		m_draw_stream->bindVertexBuffer(0, vb, 0, sizeof(Rml::Vertex));
+		m_draw_stream->bindVertexBuffer(0, vb, vb_offset, sizeof(Rml::Vertex));
 		m_draw_stream->bindVertexBuffer(1, gpu::INVALID_BUFFER, 0, 0);
-		m_draw_stream->drawIndexed(0, num_indices, gpu::DataType::U32);
-		
-		m_draw_stream->freeMemory(vertices_mem.data, m_renderer->getAllocator());
-		m_draw_stream->freeMemory(indices_mem.data, m_renderer->getAllocator());
-		
-		m_draw_stream->destroy(vb);
-		m_draw_stream->destroy(ib);
+		m_draw_stream->drawIndexed(ib_offset, num_indices, gpu::DataType::U32);
 	}
 
-	~RmlRenderInterface() {
-		if (m_shader) m_shader->decRefCount();
-	}
-
-	// Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) { return {}; }
-	// void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) {}
-	// void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) {}
+	void EnableScissorRegion(bool enable) override {
+		if (m_recording) {
+			RenderCommand& cmd = m_recording->commands.emplace();
+			cmd.type = RenderCommand::Type::ENABLE_SCISSOR;
+			cmd.enable_scissor = enable;
+		}
 
-	void EnableScissorRegion(bool enable) override { m_scissor_enabled = enable; }
+		if (enable != m_scissor_enabled) {
+			flushBatch();
+			m_scissor_dirty = true;
+		}
+		m_scissor_enabled = enable;
+	}
 
 	void SetScissorRegion(int x, int y, int width, int height) override {
+		if (m_recording) {
+			RenderCommand& cmd = m_recording->commands.emplace();
+			cmd.type = RenderCommand::Type::SET_SCISSOR;
+			cmd.scissor = IVec4(x, y, width, height);
+		}
+
+		if (m_scissor.x == x && m_scissor.y == y && m_scissor.z == width && m_scissor.w == height) return;
+		
+		if (m_scissor_enabled) {
+			flushBatch();
+			m_scissor_dirty = true;
+		}
 		m_scissor.x = x;
 		m_scissor.y = y;
 		m_scissor.z = width;
 		m_scissor.w = height;
 	}
 
+	// projects scissor rectangle from 3D canvas to screen, result is conservative if canvas is not facing the camera
+	bool projectScissor(IVec4& rect) const {
+		const DVec3 canvas_pos = m_viewport.pos + m_pos;
+		const Vec3 xaxis = m_rot.rotate(Vec3(1, 0, 0));
+		const Vec3 yaxis = m_rot.rotate(Vec3(0, 1, 0));
+		const Vec3 cam_dir = m_viewport.rot.rotate(Vec3(0, 0, -1));
+		
+		float min_x = FLT_MAX, min_y = FLT_MAX, max_x = -FLT_MAX, max_y = -FLT_MAX;
+		for (u32 i = 0; i < 4; ++i) {
+			const float x = float(m_scissor.x + (i & 1 ? m_scissor.z : 0));
+			const float y = float(m_scissor.y + (i & 2 ? m_scissor.w : 0));
+			// same mapping as in transformMousePos
+			const DVec3 p = canvas_pos + xaxis * (x / m_canvas_size.x) + yaxis * (1 - y / m_canvas_size.y);
+			if (dot(Vec3(p - m_viewport.pos), cam_dir) < m_viewport.near) return false;
+
+			const Vec2 screen = m_viewport.worldToScreenPixels(p);
+			min_x = minimum(min_x, screen.x);
+			min_y = minimum(min_y, screen.y);
+			max_x = maximum(max_x, screen.x);
+			max_y = maximum(max_y, screen.y);
+		}
+		rect.x = i32(min_x);
+		rect.y = i32(min_y);
+		rect.z = i32(ceilf(max_x)) - rect.x;
+		rect.w = i32(ceilf(max_y)) - rect.y;
+		return true;
+	}
+
+	void applyScissor() {
+		m_scissor_dirty = false;
+		
+		IVec4 rect(0, 0, i32(m_canvas_size.x), i32(m_canvas_size.y));
+		if (m_scissor_enabled) {
+			if (!m_is_3d) rect = m_scissor;
+			else projectScissor(rect);
+		}
+
+		const i32 x0 = clamp(rect.x, 0, i32(m_canvas_size.x));
+		const i32 y0 = clamp(rect.y, 0, i32(m_canvas_size.y));
+		const i32 x1 = clamp(rect.x + rect.z, x0, i32(m_canvas_size.x));
+		const i32 y1 = clamp(rect.y + rect.w, y0, i32(m_canvas_size.y));
+		// rml's origin is top left, gpu's is bottom left
+		m_draw_stream->scissor(x0, i32(m_canvas_size.y) - y1, x1 - x0, y1 - y0);
+	}
+
+	i32 allocTexture() {
+		if (m_first_free_texture < 0) {
+			m_textures.emplace();
+			return m_textures.size() - 1;
+		}
+		const i32 idx = m_first_free_texture;
+		m_first_free_texture = m_textures[idx].next_free;
+		m_textures[idx].next_free = -1;
+		return idx;
+	}
+
+	void releaseTexture(i32 idx) {
+		RmlTexture& t = m_textures[idx];
+		ASSERT(t.ref_count > 0);
+		--t.ref_count;
+		if (t.ref_count > 0) return;
+
+		// neither resource manager nor draw stream are thread safe, released in applyDeferredTextureChanges
+		if (m_defer_texture_changes) {
+			m_deferred_releases.push(idx);
+			return;
+		}
+		destroyTexture(idx);
+	}
+
+	void destroyTexture(i32 idx) {
+		RmlTexture& t = m_textures[idx];
+		if (!t.path.isEmpty()) {
+			if (t.resource) t.resource->decRefCount();
+			t.resource = nullptr;
+			t.path = Path();
+		}
+		else {
+			m_renderer->getDrawStream().destroy(t.handle);
+			t.handle = gpu::INVALID_TEXTURE;
+		}
+		t.next_free = m_first_free_texture;
+		m_first_free_texture = idx;
+	}
+
+	// loading is asynchronous, returns index of texture even if it's not loaded yet
+	i32 requestTexture(const Path& path) {
+		for (i32 i = 0, c = m_textures.size(); i < c; ++i) {
+			RmlTexture& t = m_textures[i];
+			if (t.ref_count > 0 && t.path == path) {
+				++t.ref_count;
+				return i;
+			}
+		}
+
+		const i32 idx = allocTexture();
+		RmlTexture& t = m_textures[idx];
+		t.path = path;
+		t.ref_count = 1;
+		// resource manager is not thread safe, loads requested from update jobs are started in applyDeferredTextureChanges
+		if (m_defer_texture_changes) {
+			m_deferred_textures.push(idx);
+			return idx;
+		}
+		t.resource = m_engine.getResourceManager().load<Texture>(path);
+		if (t.resource->isEmpty()) m_pending_textures.push(idx);
+		return idx;
+	}
+
+	// textures which are not loaded yet are reported as 0x0, once they are loaded, rml is told to reload them (see processLoadedTextures)
 	bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source) override {
-		Texture* t = m_engine.getResourceManager().load<Texture>(Path(source.c_str()));
-		// unfortunately we have to do this until rml has API to query textures
-		// TODO use Rml::GetTextureSourceList();
-		while (t->isEmpty()) {
-			m_engine.getFileSystem().processCallbacks();
-			os::sleep(1);
-		}
-		if (t->isFailure()) return false;
-		texture_dimensions.x = t->width;
-		texture_dimensions.y = t->height;
-		texture_handle = (uintptr_t)t->handle;
+		MutexGuard guard(m_texture_mutex);
+		const i32 idx = requestTexture(Path(source.c_str()));
+		const Texture* t = m_textures[idx].resource;
+		if (t && t->isFailure()) {
+			releaseTexture(idx);
+			return false;
+		}
+		
+		const bool ready = t && t->isReady();
+		texture_dimensions.x = ready ? t->width : 0;
+		texture_dimensions.y = ready ? t->height : 0;
+		texture_handle = Rml::TextureHandle(idx + 1);
 		return true;
 	}
 
@@ -107,14 +452,71 @@ struct RmlRenderInterface : Rml::RenderInterface {
 		m_draw_stream->createTexture(handle, source_dimensions.x, source_dimensions.y, 1, gpu::TextureFormat::RGBA8, gpu::TextureFlags::NONE, "rml_texture");
 		m_draw_stream->update(handle, 0, 0, 0, 0, source_dimensions.x, source_dimensions.y, gpu::TextureFormat::RGBA8, mem.data, mem.size);
 		m_draw_stream->freeMemory(mem.data, m_renderer->getAllocator());
+		
+		const i32 idx = allocTexture();
+		m_textures[idx].handle = handle;
+		m_textures[idx].ref_count = 1;
+		texture_handle = Rml::TextureHandle(idx + 1);
 		return true;
 	}
 
-	void ReleaseTexture(Rml::TextureHandle texture) override { ASSERT(false); }
+	void ReleaseTexture(Rml::TextureHandle texture) override {
+		MutexGuard guard(m_texture_mutex);
+		releaseTexture(i32(texture - 1));
+	}
+
+	// while set, texture requests only reserve a slot and released textures keep theirs, so rml contexts can be updated from jobs
+	void deferTextureChanges(bool defer) { m_defer_texture_changes = defer; }
+
+	void applyDeferredTextureChanges() {
+		for (i32 idx : m_deferred_releases) destroyTexture(idx);
+		m_deferred_releases.clear();
+
+		for (i32 idx : m_deferred_textures) {
+			RmlTexture& t = m_textures[idx];
+			// released before its load could start
+			if (t.ref_count == 0) continue;
+			// rml was told the texture is 0x0, processLoadedTextures makes it ask again once it's loaded
+			t.resource = m_engine.getResourceManager().load<Texture>(t.path);
+			m_pending_textures.push(idx);
+		}
+		m_deferred_textures.clear();
+	}
+
+	// tells rml about textures which finished loading since last call, so it can relayout with their real size
+	// Rml::ReleaseTexture also marks contexts dirty, so recorded draws referencing the old handles are not replayed
+	void processLoadedTextures() {
+		// keep textures from last frame alive until rml had a chance to request them again
+		for (i32 idx : m_loaded_textures) releaseTexture(idx);
+		m_loaded_textures.clear();
+
+		for (i32 i = m_pending_textures.size() - 1; i >= 0; --i) {
+			const i32 idx = m_pending_textures[i];
+			RmlTexture& t = m_textures[idx];
+			if (t.resource && t.resource->isEmpty()) continue;
+
+			m_pending_textures.swapAndPop(i);
+			if (!t.resource || !t.resource->isReady()) continue;
+			
+			++t.ref_count;
+			m_loaded_textures.push(idx);
+		}
+		if (m_loaded_textures.empty()) return;
+
+		for (const Rml::String& source : Rml::GetTextureSourceList()) {
+			const Path path(source.c_str());
+			for (i32 idx : m_loaded_textures) {
+				if (m_textures[idx].path == path) {
+					Rml::ReleaseTexture(source);
+					break;
+				}
+			}
+		}
+	}
 
 	// void SetTransform(const Matrix4f* transform);
 
-	bool beginRender(Renderer& renderer, const Vec2& canvas_size, bool is_3D, const Vec3& pos, const Quat& rot, IAllocator& allocator) {
+	bool beginRender(Renderer& renderer, const Viewport& vp, const Vec2& canvas_size, bool is_3D, const Vec3& pos, const Quat& rot, IAllocator& allocator) {
 		if (!m_shader->isReady()) return false;
 
 		gpu::VertexDecl decl(gpu::PrimitiveType::TRIANGLES);
@@ -127,37 +529,95 @@ struct RmlRenderInterface : Rml::RenderInterface {
 		m_is_3d = is_3D;
 		m_pos = pos;
 		m_rot = rot;
+		m_viewport = vp;
 		
 		m_draw_stream = &renderer.getDrawStream().createSubstream();
 		m_renderer = &renderer;
 		m_canvas_size = canvas_size;
 		
 		m_scissor_enabled = false;
+		m_scissor_dirty = true;
+		m_stats = {};
 		return true;
 	}
 
+	// records all following rml render calls until endRender
+	void record(RenderCommands& commands) {
+		commands.clear();
+		m_recording = &commands;
+	}
+
+	// draws what was recorded, the canvas transform and camera can differ from when it was recorded
+	void replay(RenderCommands& commands) {
+		for (const RenderCommand& cmd : commands.commands) {
+			switch (cmd.type) {
+				case RenderCommand::Type::GEOMETRY:
+					RenderGeometry(commands.vertices.begin() + cmd.first_vertex, cmd.num_vertices, commands.indices.begin() + cmd.first_index, cmd.num_indices, cmd.texture, cmd.translation);
+					break;
+				case RenderCommand::Type::COMPILED_GEOMETRY: RenderCompiledGeometry(cmd.geometry, cmd.translation); break;
+				case RenderCommand::Type::ENABLE_SCISSOR: EnableScissorRegion(cmd.enable_scissor); break;
+				case RenderCommand::Type::SET_SCISSOR: SetScissorRegion(cmd.scissor.x, cmd.scissor.y, cmd.scissor.z, cmd.scissor.w); break;
+			}
+		}
+	}
+
+	void endRender() {
+		m_recording = nullptr;
+		flushBatch();
+		// do not leak our scissor to whatever is rendered after us
+		if (m_scissor_enabled) {
+			m_scissor_enabled = false;
+			applyScissor();
+		}
+	}
+
 	IAllocator& m_allocator;
 	Vec3 m_pos;
 	Quat m_rot;
+	Viewport m_viewport;
 	bool m_is_3d;
 	Engine& m_engine;
 	Renderer* m_renderer = nullptr;
 	u32 m_3D_define = 0;
 	DrawStream* m_draw_stream = nullptr;
 	bool m_scissor_enabled = false;
-	IVec4 m_scissor;
+	IVec4 m_scissor = IVec4(0, 0, 0, 0);
+	bool m_scissor_dirty = true;
 	Shader* m_shader = nullptr;
 	Vec2 m_canvas_size;
 	gpu::ProgramHandle m_program_3D;
 	gpu::ProgramHandle m_program_2D;
+	Array<CompiledGeometry> m_compiled_geometries;
+	i32 m_first_free_geometry = -1;
+	Array<Rml::Vertex> m_batch_vertices;
+	Array<u32> m_batch_indices;
+	Rml::TextureHandle m_batch_texture = 0;
+	Array<RmlTexture> m_textures;
+	i32 m_first_free_texture = -1;
+	Array<i32> m_pending_textures;
+	Array<i32> m_loaded_textures;
+	Array<i32> m_deferred_textures;
+	Array<i32> m_deferred_releases;
+	RenderCommands* m_recording = nullptr;
+	Mutex m_texture_mutex;
+	Mutex m_geometry_mutex;
+	bool m_defer_texture_changes = false;
+	RMLModule::CanvasStats m_stats;
 };
 
 struct RMLModuleImpl : RMLModule {
 	struct Canvas {
+		Canvas(IAllocator& allocator) : commands(allocator) {}
+
 		EntityRef entity;
 		bool is_3d = true;
 		IVec2 virtual_size = {800, 600};
+		float max_distance = 0; // 3D canvases further from camera are not rendered nor updated, 0 means no limit
+		bool visible = true; // rendered by any pipeline since last update
+		bool parallel_update = false; // updated on a job, so its event listeners and data model callbacks must be thread safe
 		Rml::Context* context;
+		CanvasStats stats;
+		RmlRenderInterface::RenderCommands commands;
 	};
 
 	RMLModuleImpl(ISystem& system, Engine& engine, World& world)
@@ -165,6 +625,7 @@ struct RMLModuleImpl : RMLModule {
 		, m_system(system)
 		, m_world(world)
 		, m_canvases(engine.getAllocator())
+		, m_preloaded_textures(engine.getAllocator())
 		, m_render_interface(engine, engine.getAllocator())
 	{}
 
@@ -173,24 +634,24 @@ struct RMLModuleImpl : RMLModule {
 			StaticString<64> context_name((u64)this, "#", c.entity.index);
 			Rml::RemoveContext(context_name.data);
 		}
+		if (m_preload_context) {
+			Rml::RemoveContext(m_preload_context->GetName());
+		}
+		for (i32 idx : m_preloaded_textures) m_render_interface.releaseTexture(idx);
+		// rml's texture database outlives us
+		Rml::ReleaseTextures(&m_render_interface);
 	}
 
 	const char* getName() const override { return "rml"; }
 
 	void createCanvas(EntityRef entity) {
 		if (!m_focused.isValid()) m_focused = entity;
-		Canvas& c = m_canvases.emplace();
+		Canvas& c = m_canvases.emplace(m_engine.getAllocator());
 		c.entity = entity;
 		StaticString<64> context_name((u64)this, "#", entity.index);
 		c.context = Rml::CreateContext(context_name.data, Rml::Vector2i(800, 600), &m_render_interface);
-		OutputMemoryStream content(m_engine.getAllocator());
-		if (m_engine.getFileSystem().getContentSync(Path("rml/demo.rml"), content)) {
-			content.write((char)0);
-			Rml::String str;
-			str = (const char*)content.data();
-			Rml::ElementDocument* doc = c.context->LoadDocumentFromMemory(str, "rml/demo.rml");
-			if (doc) doc->Show();
-		}
+		Rml::ElementDocument* doc = c.context->LoadDocument("rml/demo.rml");
+		if (doc) doc->Show();
 		m_world.onComponentCreated(entity, RML_CANVAS_TYPE, this);
 	}
 
@@ -216,6 +677,22 @@ struct RMLModuleImpl : RMLModule {
 
 	void set3D(EntityRef e, bool is_3d) override { getCanvas(e)->is_3d = is_3d; }
 
+	float getMaxRenderDistance(EntityRef e) override { return getCanvas(e)->max_distance; }
+
+	void setMaxRenderDistance(EntityRef e, float distance) override { getCanvas(e)->max_distance = distance; }
+
+	bool isParallelUpdate(EntityRef e) override { return getCanvas(e)->parallel_update; }
+
+	void setParallelUpdate(EntityRef e, bool parallel) override { getCanvas(e)->parallel_update = parallel; }
+
+	CanvasStats getCanvasStats(EntityRef e) override {
+		const Canvas* canvas = getCanvas(e);
+		CanvasStats stats = canvas->stats;
+		stats.element_arena_bytes = (u32)canvas->context->GetNumElementArenaBytes();
+		stats.element_arena_allocations = (u32)canvas->context->GetNumElementArenaAllocations();
+		return stats;
+	}
+
 	void render(Pipeline& pipeline) {
 		if (!m_render_interface.m_shader) {
 			m_render_interface.m_shader = m_engine.getResourceManager().load<Shader>(Path("pipelines/rml.shd"));
@@ -224,18 +701,96 @@ struct RMLModuleImpl : RMLModule {
 		m_render_interface.m_3D_define = 1 << renderer.getShaderDefineIdx("SPATIAL");
 		const Viewport vp = pipeline.getViewport();
 
-		for (const Canvas& canvas : m_canvases) {
+		const ShiftedFrustum frustum = vp.getFrustum();
+		for (Canvas& canvas : m_canvases) {
+			const Transform& tr = m_world.getTransform(canvas.entity);
+			if (canvas.is_3d && isCulled(canvas, tr, vp, frustum)) {
+				canvas.stats = {};
+				canvas.stats.culled = true;
+				continue;
+			}
+			canvas.visible = true;
+
 			const Vec2 canvas_size((float)vp.w, (float)vp.h);
 			canvas.context->SetDimensions({vp.w, vp.h});
-			const Transform& tr = m_world.getTransform(canvas.entity);
-			if (m_render_interface.beginRender(renderer, canvas_size, canvas.is_3d, Vec3(tr.pos - vp.pos), tr.rot, renderer.getAllocator())) {
-				canvas.context->Render();
+			if (m_render_interface.beginRender(renderer, vp, canvas_size, canvas.is_3d, Vec3(tr.pos - vp.pos), tr.rot, renderer.getAllocator())) {
+				// static canvases resubmit what they drew last time, skipping rml's traversal of the whole document
+				// rml marks contexts dirty on resize and whenever it releases a texture, recorded draws may reference it
+				const bool cached = !canvas.context->IsRenderDirty();
+				if (cached) {
+					m_render_interface.replay(canvas.commands);
+				}
+				else {
+					m_render_interface.record(canvas.commands);
+					canvas.context->Render();
+				}
+				m_render_interface.endRender();
+				canvas.stats = m_render_interface.m_stats;
+				canvas.stats.cached = cached;
+				canvas.stats.layout_roots = (u32)canvas.context->GetNumLayoutRoots();
+				canvas.stats.layout_elements = (u32)canvas.context->GetNumLayoutElements();
 			}
 		}
 	}
 
+	// 3D canvas covers unit square spanned by its local x and y axes, see transformMousePos
+	bool isCulled(const Canvas& canvas, const Transform& tr, const Viewport& vp, const ShiftedFrustum& frustum) const {
+		const Vec3 xaxis = tr.rot.rotate(Vec3(1, 0, 0));
+		const Vec3 yaxis = tr.rot.rotate(Vec3(0, 1, 0));
+		if (canvas.max_distance > 0) {
+			const Vec3 center = Vec3(tr.pos - vp.pos) + (xaxis + yaxis) * 0.5f;
+			if (squaredLength(center) > canvas.max_distance * canvas.max_distance) return true;
+		}
+
+		const Vec3 corners[] = { xaxis, yaxis, xaxis + yaxis };
+		Vec3 min(0, 0, 0), max(0, 0, 0);
+		for (const Vec3& corner : corners) {
+			min.x = minimum(min.x, corner.x);
+			min.y = minimum(min.y, corner.y);
+			min.z = minimum(min.z, corner.z);
+			max.x = maximum(max.x, corner.x);
+			max.y = maximum(max.y, corner.y);
+			max.z = maximum(max.z, corner.z);
+		}
+		return !frustum.intersectsAABB(tr.pos + min, max - min);
+	}
+
 	void focus(EntityPtr e) { m_focused = e; }
 
+	void prefetchDocument(const Path& path) override {
+		// the file interface is always ours, see RMLSystem::initBegin
+		static_cast<RmlFileInterface*>(Rml::GetFileInterface())->prefetchDocument(path);
+	}
+
+	void preloadDocumentAssets(const Path& path) override {
+		if (!m_preload_context) {
+			StaticString<64> context_name((u64)this, "#preload");
+			m_preload_context = Rml::CreateContext(context_name.data, Rml::Vector2i(800, 600), &m_render_interface);
+		}
+
+		const Rml::StringList prev_sources = Rml::GetTextureSourceList();
+		Rml::ElementDocument* doc = m_preload_context->LoadDocument(path.c_str());
+		if (!doc) {
+			logError("Failed to load ", path);
+			return;
+		}
+
+		// resolves styles and layout, so all textures used by the document end up in rml's texture database
+		doc->UpdateDocument();
+		for (const Rml::String& source : Rml::GetTextureSourceList()) {
+			bool is_new = true;
+			for (const Rml::String& prev : prev_sources) {
+				if (prev == source) {
+					is_new = false;
+					break;
+				}
+			}
+			if (is_new) m_preloaded_textures.push(m_render_interface.requestTexture(Path(source.c_str())));
+		}
+		m_preload_context->UnloadDocument(doc);
+		m_preload_context->Update();
+	}
+
 	IVec2 transformMousePos(const Canvas& canvas, float x, float y) const {
 		if (canvas.is_3d) {
 			RenderModule* render_module = static_cast<RenderModule*>(m_world.getModule("renderer"));
@@ -269,20 +824,33 @@ struct RMLModuleImpl : RMLModule {
 	}
 
 	void update(float time_delta) override {
+		m_render_interface.processLoadedTextures();
+
 		const Canvas* focused = m_focused.isValid() ? getCanvas((EntityRef)m_focused) : nullptr;
 		if (focused) {
 			InputSystem& is = m_engine.getInputSystem();
 			Span<const InputSystem::Event> events = is.getEvents();
+			// consecutive mouse moves are merged, so rml updates hover once per frame and not once per raw event
+			// the last position is sent before each click, so clicks still land where they happened
+			bool mouse_moved = false;
+			Vec2 mouse_pos;
+			auto flushMouseMove = [&](){
+				if (!mouse_moved) return;
+				mouse_moved = false;
+				const IVec2 mp = transformMousePos(*focused, mouse_pos.x, mouse_pos.y);
+				focused->context->ProcessMouseMove(mp.x, mp.y, 0);
+			};
 			for (const InputSystem::Event& e : events) {
 				switch (e.type) {
 					case InputSystem::Event::AXIS:
 						if (e.device->type == InputSystem::Device::MOUSE) {
-							const IVec2 mp = transformMousePos(*focused, e.data.axis.x_abs, e.data.axis.y_abs);
-							focused->context->ProcessMouseMove(mp.x, mp.y, 0);
+							mouse_moved = true;
+							mouse_pos = Vec2(e.data.axis.x_abs, e.data.axis.y_abs);
 						}
 						break;
 					case InputSystem::Event::BUTTON:
 						if (e.device->type == InputSystem::Device::MOUSE) {
+							flushMouseMove();
 							if (e.data.button.down) {
 								focused->context->ProcessMouseButtonDown(0, 0);
 							} else {
@@ -295,8 +863,31 @@ struct RMLModuleImpl : RMLModule {
 						break;
 				}
 			}
+			flushMouseMove();
+		}
+
+		// event listeners and data model callbacks are called from Update, so only canvases which opted in are updated on jobs
+		for (Canvas& canvas : m_canvases) {
+			if (!canvas.parallel_update) updateCanvas(canvas);
 		}
-		for (const Canvas& c : m_canvases) c.context->Update();
+
+		// contexts are independent, rml's shared state is guarded by locks, see e.g. StyleSheet::GetElementDefinition
+		m_render_interface.deferTextureChanges(true);
+		jobs::forEach(m_canvases.size(), 1, [&](i32 i, i32){
+			Canvas& canvas = m_canvases[i];
+			if (canvas.parallel_update) updateCanvas(canvas);
+		});
+		m_render_interface.deferTextureChanges(false);
+		m_render_interface.applyDeferredTextureChanges();
+	}
+
+	void updateCanvas(Canvas& canvas) {
+		// canvases culled by all pipelines last frame are not updated, render sets the flag again once they are in view
+		if (!canvas.visible) return;
+		canvas.visible = !canvas.is_3d;
+
+		PROFILE_BLOCK("rml context update");
+		canvas.context->Update();
 	}
 
 	void serialize(struct OutputMemoryStream& serializer) override {}
@@ -312,6 +903,8 @@ struct RMLModuleImpl : RMLModule {
 	RmlRenderInterface m_render_interface;
 	World& m_world;
 	Array<Canvas> m_canvases;
+	Rml::Context* m_preload_context = nullptr;
+	Array<i32> m_preloaded_textures;
 };
 
 UniquePtr<RMLModule> RMLModule::create(ISystem& system, Engine& engine, World& world) {
@@ -321,7 +914,9 @@ UniquePtr<RMLModule> RMLModule::create(ISystem& system, Engine& engine, World& w
 void RMLModule::reflect() {
 	LUMIX_MODULE(RMLModuleImpl, "rml")
 		.LUMIX_CMP(Canvas, "rml_canvas", "RML / Canvas")
-			.prop<&RMLModule::is3D, &RMLModule::set3D>("Is 3D");
+			.prop<&RMLModule::is3D, &RMLModule::set3D>("Is 3D")
+			.prop<&RMLModule::getMaxRenderDistance, &RMLModule::setMaxRenderDistance>("Max render distance")
+			.prop<&RMLModule::isParallelUpdate, &RMLModule::setParallelUpdate>("Parallel update");
 }
 
 } // namespace Lumix
\ No newline at end of file
@@ -5,9 +5,31 @@
 namespace Lumix {
 
 struct RMLModule : IModule {
+	struct CanvasStats {
+		u32 draws_submitted = 0; // draws requested by rml
+		u32 draws_emitted = 0; // draws actually sent to the GPU after batching
+		u32 bytes_uploaded = 0; // vertex and index bytes uploaded in last frame
+		u32 layout_roots = 0; // documents or layout boundaries formatted in last update
+		u32 layout_elements = 0; // elements formatted in last update
+		u32 element_arena_bytes = 0; // bytes currently allocated from element arenas of the canvas' documents
+		u32 element_arena_allocations = 0; // number of elements and their meta data currently allocated from the arenas
+		bool culled = false; // 3D canvas outside of frustum or max render distance
+		bool cached = false; // context did not change, draws recorded earlier were resubmitted
+	};
+
 	virtual bool is3D(EntityRef e) = 0;
 	virtual void set3D(EntityRef e, bool is_3d) = 0;
+	virtual float getMaxRenderDistance(EntityRef e) = 0;
+	virtual void setMaxRenderDistance(EntityRef e, float distance) = 0;
+	// parallel canvases are updated on jobs, their event listeners and data model callbacks must be thread safe
+	virtual bool isParallelUpdate(EntityRef e) = 0;
+	virtual void setParallelUpdate(EntityRef e, bool parallel) = 0;
 	virtual void render(struct Pipeline& pipeline) = 0;
+	virtual CanvasStats getCanvasStats(EntityRef e) = 0;
+	// asynchronously reads the document and stylesheets and templates it links, so loading it later does not wait on IO
+	virtual void prefetchDocument(const struct Path& path) = 0;
+	// starts loading textures used by the document in background, so they are ready once the document is shown
+	virtual void preloadDocumentAssets(const struct Path& path) = 0;
 
 	static UniquePtr<RMLModule> create(ISystem& system, Engine& engine, World& world);
 	static void reflect();
@@ -1,15 +1,21 @@
 #define LUMIX_NO_CUSTOM_CRT
 #include "RmlUi/Core.h"
 #include "engine/allocator.h"
+#include "engine/allocators.h"
+#include "engine/command_line_parser.h"
 #include "engine/engine.h"
+#include "engine/file_system.h"
 #include "engine/log.h"
 #include "engine/os.h"
 #include "engine/plugin.h"
+#include "engine/profiler.h"
 #include "engine/reflection.h"
 #include "engine/string.h"
 #include "renderer/pipeline.h"
 #include "renderer/render_module.h"
 #include "renderer/renderer.h"
+#include "rml_benchmark.h"
+#include "rml_file_interface.h"
 #include "rml_module.h"
 
 namespace Lumix {
@@ -43,9 +49,38 @@ struct SystemInterface : Rml::SystemInterface {
 	os::Timer m_timer;
 };
 
+// rml's element arenas, pools and geometry allocate from the engine, tagged so they show up in memory profiler
+// rest of rml's memory, e.g. strings or properties, still comes from the heap
+struct MemoryInterface : Rml::MemoryInterface {
+	MemoryInterface(IAllocator& allocator) : m_allocator(allocator, "rml") {}
+	void* Allocate(size_t size, size_t alignment) override { return m_allocator.allocate(size, alignment); }
+	void Deallocate(void* ptr) override { m_allocator.deallocate(ptr); }
+	TagAllocator m_allocator;
+};
+
+// rml's profiling zones show up in engine's profiler, needs RMLUI_CUSTOM_PROFILING, see genie.lua
+struct ProfilingInterface : Rml::ProfilingInterface {
+	void BeginZone(const char* name, uint32_t color) override {
+		profiler::beginBlock(name);
+		if (color) profiler::blockColor(u8(color >> 16), u8(color >> 8), u8(color));
+	}
+
+	void EndZone() override { profiler::endBlock(); }
+
+	void ZoneText(const char* text, size_t size) override {
+		char tmp[256];
+		const size_t len = minimum(size, sizeof(tmp) - 1);
+		memcpy(tmp, text, len);
+		tmp[len] = '\0';
+		profiler::pushString(tmp);
+	}
+};
+
 struct RMLSystem : ISystem {
 	RMLSystem(Engine& engine)
 		: m_engine(engine)
+		, m_memory_interface(engine.getAllocator())
+		, m_file_interface(engine.getFileSystem(), engine.getAllocator(), 16 * 1024 * 1024)
 	{
 		RMLModule::reflect();
 	}
@@ -72,6 +107,9 @@ struct RMLSystem : ISystem {
 
 	void initBegin() override {
 		Rml::SetSystemInterface(&m_system_interface);
+		Rml::SetFileInterface(&m_file_interface);
+		Rml::SetMemoryInterface(&m_memory_interface);
+		Rml::SetProfilingInterface(&m_profiling_interface);
 		Rml::Initialise();
 		// Rml::LoadFontFace("editor/fonts/NotoSans-Regular.ttf", true);
 		Rml::LoadFontFace("rml/Delicious-Bold.otf");
@@ -80,10 +118,52 @@ struct RMLSystem : ISystem {
 		Rml::LoadFontFace("rml/Delicious-Roman.otf");
 	}
 
+	// `-rml_benchmark <corpus> <output>` runs documents listed in corpus and writes the results as json, see runRmlBenchmark
+	void initEnd() override {
+		char cmd_line[2048];
+		os::getCommandLine(Span(cmd_line));
+		CommandLineParser parser(cmd_line);
+		while (parser.next()) {
+			if (!parser.currentEquals("-rml_benchmark")) continue;
+			char corpus[MAX_PATH];
+			char output[MAX_PATH];
+			if (!parser.next()) break;
+			parser.getCurrent(corpus, lengthOf(corpus));
+			if (!parser.next()) break;
+			parser.getCurrent(output, lengthOf(output));
+			runBenchmark(Path(corpus), Path(output));
+			break;
+		}
+	}
+
+	void runBenchmark(const Path& corpus_path, const Path& output_path) {
+		FileSystem& fs = m_engine.getFileSystem();
+		OutputMemoryStream corpus(m_engine.getAllocator());
+		if (!fs.getContentSync(corpus_path, corpus)) {
+			logError("Failed to read ", corpus_path);
+			return;
+		}
+
+		const Rml::String corpus_str((const char*)corpus.data(), (size_t)corpus.size());
+		OutputMemoryStream results(m_engine.getAllocator());
+		// enough frames for timings to settle, short enough to run the whole corpus in a few seconds
+		if (!runRmlBenchmark(corpus_str.c_str(), 300, m_engine.getAllocator(), results)) {
+			logError("Some documents from ", corpus_path, " could not be benchmarked");
+		}
+		if (!fs.saveContentSync(output_path, Span<const u8>(results.data(), (u32)results.size()))) {
+			logError("Failed to write ", output_path);
+			return;
+		}
+		logInfo("RML benchmark results written to ", output_path);
+	}
+
 	void createModules(World& world) override { world.addModule(RMLModule::create(*this, m_engine, world)); }
 
 	Engine& m_engine;
 	SystemInterface m_system_interface;
+	MemoryInterface m_memory_interface;
+	ProfilingInterface m_profiling_interface;
+	RmlFileInterface m_file_interface;
 	RMLRenderPlugin m_render_plugin;
 };
 